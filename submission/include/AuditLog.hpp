@@ -0,0 +1,69 @@
+#pragma once
+
+#include <atomic>
+#include <fstream>
+#include <string>
+#include <thread>
+
+#include "Constants.hpp"
+#include "Type.hpp"
+#include "MpscRing.hpp"
+
+enum class AuditKind : uint8_t { ACCEPT, FILL, CANCEL, EXPIRE };
+
+// Compact binary record pushed by the matcher; formatted only on the logger thread
+struct AuditEvent {
+    uint64_t timestampNs;  // Wall clock, for compliance
+    AuditKind kind;
+    Side side;
+    Symbol symbol;
+    OrderID orderId;       // Taker for FILL
+    OrderID counterparty;  // Maker for FILL, 0 otherwise
+    ExecID execId;         // FILL only
+    double price;
+    double quantity;       // Order size (ACCEPT), fill size (FILL), remaining (CANCEL/EXPIRE)
+};
+
+/**
+ * @brief Drop-copy / audit trail written off the matching path.
+ *
+ * record() is non-blocking and lock-free: if the ring is full the event is counted as
+ * dropped and matching carries on. A logger thread drains the ring in batches, formats
+ * one line per event and reports drops in-band ("DROPPED <n>") so gaps are visible.
+ */
+class AuditLog {
+public:
+    explicit AuditLog(const std::string& path);
+    ~AuditLog();
+
+    AuditLog(const AuditLog&) = delete;
+    AuditLog& operator=(const AuditLog&) = delete;
+
+    bool isOpen() const { return out.is_open(); }
+
+    void start();
+    void stop(); // Drains whatever is queued, then joins
+
+    bool record(const AuditEvent& event) {
+        if (ring.tryPush(event)) return true;
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    uint64_t getDropped() const { return dropped.load(std::memory_order_relaxed); }
+    uint64_t getWritten() const { return written.load(std::memory_order_relaxed); }
+
+    static uint64_t now();
+
+private:
+    MpscRing<AuditEvent, Config::AUDIT_RING_CAPACITY> ring;
+    std::ofstream out;
+    std::thread logger;
+    std::atomic<bool> running{false};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<uint64_t> written{0};
+    uint64_t reportedDrops = 0; // Logger thread only
+
+    void run();
+    size_t drainBatch(std::string& buffer);
+};
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Constants.hpp"
+
+// Why a batched order was rejected; NONE = passed. Checked in validateCommon's order.
+enum class BatchReject : uint8_t {
+    NONE = 0,
+    QUANTITY,
+    TAG,
+    SYMBOL,
+    CAPACITY,
+    STORE_FULL,
+    PRICE_RANGE,
+    FRAGMENTED,
+    PRICE_BAND
+};
+
+/**
+ * @brief One ingress batch laid out as columns (structure of arrays) for validateBatch().
+ *
+ * The gather step fills one row per order; per-book facts (band limits, fragmentation) are
+ * looked up once per symbol, not once per order, and copied into the rows.
+ */
+struct ValidationBatch {
+    std::vector<double> quantity;
+    std::vector<double> price;
+    std::vector<double> bandLow;       // -inf / +inf when the book has no last price yet
+    std::vector<double> bandHigh;
+    std::vector<uint32_t> tagLength;
+    std::vector<uint8_t> symbolEmpty;
+    std::vector<uint8_t> fragmented;   // Book at MAX_PRICE_LEVELS
+
+    // Output
+    std::vector<BatchReject> reason;
+    std::vector<uint64_t> rejectMask;  // Bit i of word i / 64 set = order i rejected
+
+    size_t size() const { return quantity.size(); }
+    void resize(size_t n);
+    bool isRejected(size_t i) const { return (rejectMask[i / 64] >> (i % 64)) & 1; }
+};
+
+/**
+ * Runs every numeric check over the whole batch in branch-free loops the compiler can
+ * vectorize, then packs the reject bitmask. Capacity and store checks depend on how many
+ * orders survive, so the caller applies them afterwards. Returns the number rejected.
+ */
+size_t validateBatch(ValidationBatch& batch);
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+/**
+ * @brief Machine-readable benchmark results ("kraken-bench/1").
+ *
+ * Every benchmark records its metrics here in addition to its console table; the report
+ * is written as JSON when BENCH_REPORT names an output file. tools/bench_compare.py checks
+ * a report against a stored baseline.
+ *
+ * Distribution metrics carry n/mean/stddev (for significance tests) and tail percentiles;
+ * scalar metrics carry a single value. 'better' tells the comparer which direction regresses.
+ */
+class BenchReport {
+public:
+    enum class Better { LOWER, HIGHER };
+
+    explicit BenchReport(std::string suite) : suite(std::move(suite)) {}
+
+    // Summarises raw samples; the vector is sorted in place
+    void addDistribution(const std::string& name, const std::string& unit, Better better,
+                         std::vector<double>& samples) {
+        if (samples.empty()) return;
+        std::sort(samples.begin(), samples.end());
+        double n = static_cast<double>(samples.size());
+        double mean = std::accumulate(samples.begin(), samples.end(), 0.0) / n;
+        double sq = 0.0;
+        for (double s : samples) sq += (s - mean) * (s - mean);
+        double stddev = samples.size() > 1 ? std::sqrt(sq / (n - 1.0)) : 0.0;
+        auto pct = [&](double p) {
+            return samples[std::min(samples.size() - 1, static_cast<size_t>(n * p / 100.0))];
+        };
+
+        std::ostringstream m;
+        m << "{" << field("name", name) << "," << field("unit", unit) << "," << field("better", better)
+          << ",\"samples\":" << samples.size() << ",\"mean\":" << num(mean) << ",\"stddev\":" << num(stddev)
+          << ",\"p50\":" << num(pct(50)) << ",\"p90\":" << num(pct(90)) << ",\"p99\":" << num(pct(99))
+          << ",\"p999\":" << num(pct(99.9)) << ",\"max\":" << num(samples.back()) << "}";
+        metrics.push_back(m.str());
+    }
+
+    void addScalar(const std::string& name, const std::string& unit, Better better, double value) {
+        std::ostringstream m;
+        m << "{" << field("name", name) << "," << field("unit", unit) << "," << field("better", better)
+          << ",\"samples\":1,\"mean\":" << num(value) << ",\"stddev\":0}";
+        metrics.push_back(m.str());
+    }
+
+    std::string toJson() const {
+        std::ostringstream out;
+        out << "{\"schema\":\"kraken-bench/1\"," << field("suite", suite) << ",\"environment\":" << environment()
+            << ",\"metrics\":[";
+        for (size_t i = 0; i < metrics.size(); ++i) out << (i ? "," : "") << "\n  " << metrics[i];
+        out << "\n]}\n";
+        return out.str();
+    }
+
+    // Writes to $BENCH_REPORT if set; returns false only on an I/O failure
+    bool writeIfRequested() const {
+        const char* path = std::getenv("BENCH_REPORT");
+        if (!path || !*path) return true;
+        std::ofstream file(path);
+        file << toJson();
+        return static_cast<bool>(file);
+    }
+
+private:
+    std::string suite;
+    std::vector<std::string> metrics;
+
+    static std::string escape(const std::string& s) {
+        std::string out;
+        for (char c : s) {
+            if (c == '"' || c == '\\') out += '\\';
+            if (static_cast<unsigned char>(c) >= 0x20) out += c;
+        }
+        return out;
+    }
+    static std::string field(const char* key, const std::string& value) {
+        return "\"" + std::string(key) + "\":\"" + escape(value) + "\"";
+    }
+    static std::string field(const char* key, Better better) {
+        return field(key, std::string(better == Better::LOWER ? "lower" : "higher"));
+    }
+    static std::string num(double v) {
+        std::ostringstream s;
+        s.precision(6);
+        s << std::fixed << v;
+        return s.str();
+    }
+
+    static std::string environment() {
+        char host[256] = {0};
+        gethostname(host, sizeof(host) - 1);
+
+        std::time_t now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+        char stamp[32];
+        std::strftime(stamp, sizeof(stamp), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+        const char* rev = std::getenv("BENCH_REVISION"); // e.g. BENCH_REVISION=$(git rev-parse HEAD)
+#ifdef NDEBUG
+        const std::string build = "release";
+#else
+        const std::string build = "debug";
+#endif
+        std::ostringstream env;
+        env << "{" << field("timestamp", stamp) << "," << field("host", host)
+            << "," << field("compiler", __VERSION__) << "," << field("build", build)
+            << ",\"cpus\":" << std::thread::hardware_concurrency()
+            << "," << field("revision", rev ? rev : "") << "}";
+        return env.str();
+    }
+};
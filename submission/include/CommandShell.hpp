@@ -0,0 +1,63 @@
+#pragma once
+
+#include <string_view>
+#include <charconv>
+#include <optional>
+
+#include "TradingEngine.hpp"
+
+// --- High-Performance Zero-Copy Utilities ---
+
+/**
+ * Advanced string_view window to extract tokens without allocation.
+ */
+inline std::string_view get_next_token(std::string_view& input) {
+    auto start = input.find_first_not_of(" \t\r\n");
+    if (start == std::string_view::npos) return "";
+    input.remove_prefix(start);
+
+    auto end = input.find_first_of(" \t\r\n");
+    std::string_view token = input.substr(0, end);
+    input.remove_prefix(end == std::string_view::npos ? input.size() : end);
+    return token;
+}
+
+/**
+ * Fast integer conversion using <charconv>.
+ */
+template<typename T>
+inline T to_num(std::string_view sv) {
+    T val{};
+    if (sv.empty()) return val;
+    std::from_chars(sv.data(), sv.data() + sv.size(), val);
+    return val;
+}
+
+/**
+ * Fast double conversion using <charconv>.
+ */
+inline double to_double(std::string_view sv) {
+    double val = 0.0;
+    if (sv.empty()) return val;
+    // Note: ensure your compiler fully supports floating point from_chars (C++20)
+    std::from_chars(sv.data(), sv.data() + sv.size(), val);
+    return val;
+}
+
+// --- Command Dispatch ---
+
+/**
+ * Runs one shell command ('cmd' already split off, 'args' the rest of the line) against
+ * the engine. Shared by the interactive shell and the replay tool so both speak the same
+ * language. Returns nullopt for commands it does not know; session commands such as QUIT
+ * are the caller's business. A non-zero 'session' owns the orders it enters and may only
+ * CANCEL those; session 0 (the local shell) may cancel anything.
+ */
+std::optional<EngineResponse> dispatchCommand(TradingEngine& engine, std::string_view cmd, std::string_view args,
+                                              SessionID session = 0);
+
+/**
+ * Order entry and queries: the commands a remote peer may send. Session-wide ones such as
+ * RESET (which also truncates an attached journal) stay with the local shell.
+ */
+bool isGatewayCommand(std::string_view cmd);
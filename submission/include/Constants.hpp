@@ -1,6 +1,11 @@
 #pragma once
 
 #include <set>
+#include <array>
+#include <vector>
+#include <algorithm>
+#include <string_view>
+#include <cmath>
 #include <string>
 
 // ====================================================================
@@ -25,12 +30,74 @@ namespace Config {
     inline constexpr long MAX_ORDERS_PER_BOOK = 1'000'000;  // Prevents one symbol from eating all RAM; ensure not all RAM is used up by the most actively traded symbol
     inline constexpr int  MAX_PRICE_LEVELS    = 20'000;     // Prevents "Quote Stuffing" fragmenting the map; the limit keeps the time it takes to find a price -- O(log N) -- performant.
     inline constexpr int  MAX_TAG_SIZE        = 64;         // Max bytes for user-provided string tags; Memory fragmentation and Small String Optimization
+    inline constexpr int  SHADOW_VERSIONS     = 8;          // Published shadow versions kept per book; bounds how far a multi-book cut may lag
+    inline constexpr int  SNAPSHOT_CUT_RETRIES = 16;        // Fresh epochs tried before a multi-book cut gives up (history overrun)
+
+    // 3b. Grouped Depth (served from incrementally maintained buckets)
+    inline constexpr std::array<double, 2> DEPTH_BUCKET_SIZES = {1.0, 10.0}; // Price bands a book aggregates into
+    inline constexpr size_t MAX_GROUPED_DEPTH = 50;                         // Buckets per side published per version
+
+    // 3c. Rendered Snapshot Cache (shared immutable bytes per book version)
+    inline constexpr size_t RENDER_CACHE_SLOTS = 4; // (format, depth) renderings kept per book
 
     // 4. Validation Limits (Trading Rules)
     inline constexpr long   MAX_ORDER_QTY     = 1'000'000'000; // "Fat Finger" protection
     inline constexpr double MIN_ORDER_PRICE   = 0.00000001;    // Minimum tick size; Standard Satoshi-level precision.
     inline constexpr double MAX_ORDER_PRICE   = 1'000'000'000.0;
     inline constexpr double PRICE_BAND_PERCENT = 1.0;            // Limits the resting orders and clutter in Orderbook
+
+    // 5. Idle-Time Maintenance (runs only while ingress is quiet)
+    inline constexpr size_t ARCHIVE_BATCH  = 256;  // Terminal orders moved to the archive per idle slice
+    inline constexpr size_t WARM_LEVELS    = 4;    // Levels per side touched when keeping top-of-book cache-warm
+    inline constexpr int    IDLE_BURST_US  = 500;  // Longest idle burst before input is re-checked from the top
+    inline constexpr int    IDLE_POLL_MS   = 50;   // Wait for input once all maintenance is drained
+
+    // 6. Persistent Order Store (optional mmap-backed slab)
+    inline constexpr size_t STORE_CAPACITY = 1'000'000; // Order records per slab file (~200 bytes each, sparse until used)
+
+    // 7. Audit Log (drained by its own thread; matching never waits on it)
+    inline constexpr size_t AUDIT_RING_CAPACITY = 65536; // Events buffered before drops start (power of two)
+    inline constexpr size_t AUDIT_BATCH         = 512;   // Events formatted per write
+    inline constexpr int    AUDIT_IDLE_US       = 100;   // Logger back-off when the ring is empty
+
+    // 8. Session Egress (execution reports for both sides of every fill)
+    inline constexpr size_t EGRESS_RING_CAPACITY = 4096; // Reports buffered per session before drops (power of two)
+    inline constexpr size_t UPDATE_QUEUE_CAPACITY = 4096; // Order updates buffered per queue subscriber (power of two)
+
+    // 9. Retransmission (sequenced outbound streams, gap fills served off the matching path)
+    inline constexpr size_t RETRANSMIT_CAPACITY  = 65536; // Messages kept per stream for gap fills (power of two)
+    inline constexpr size_t GAPFILL_QUEUE_CAPACITY = 256; // Pending gap-fill requests (power of two)
+    inline constexpr size_t GAPFILL_MAX_MESSAGES = 4096;  // Largest range served by one reply
+    inline constexpr int    GAPFILL_IDLE_US      = 200;   // Server back-off when no request is queued
+
+    // 10. Market-Data Fan-Out (L2/trade events over UDP, sent off the matching thread)
+    inline constexpr size_t MD_RING_CAPACITY       = 16384; // Events kept per book; readers further behind are lapped (power of two)
+    inline constexpr size_t MD_EVENTS_PER_DATAGRAM = 28;    // Events batched into one datagram (fits MD_MAX_DATAGRAM)
+    inline constexpr size_t MD_MAX_DATAGRAM        = 1472;  // Ethernet MTU minus IPv4/UDP headers
+    inline constexpr size_t MD_DATAGRAMS_PER_SEND  = 16;    // Datagrams handed to one sendmmsg() call
+    inline constexpr int    MD_IDLE_US             = 50;    // Publisher back-off when every ring is empty
+
+    // 11. UDP Order Gateway (drained by the matcher between shell commands)
+    inline constexpr size_t GATEWAY_BATCH        = 64;   // Datagrams served per drain before yielding
+    inline constexpr size_t GATEWAY_MAX_DATAGRAM = 2048; // Largest request accepted (one command line)
+    inline constexpr size_t GATEWAY_MAX_PEERS    = 1024; // Distinct peer addresses given a session
+    inline constexpr uint32_t GATEWAY_FIRST_SESSION = 1u << 24; // Gateway sessions start here, clear of local ones
+
+    // 12. Duplicate-Tag Filter (blocked Bloom filter in front of the exact tag maps)
+    inline constexpr size_t TAG_FILTER_BLOCKS = 131072; // 64-byte blocks (8 MiB); ~4% false positives at MAX_GLOBAL_ORDERS tags
+    inline constexpr size_t TAG_FILTER_HASHES = 6;      // Bits set per tag inside its block
+
+    // 13. Order Journal (compact write-ahead log of accepted requests)
+    inline constexpr size_t JOURNAL_BLOCK_BYTES    = 64 * 1024;   // Payload per block: sealed for the syncer when full, one seek step
+    inline constexpr double JOURNAL_TICKS_PER_UNIT = 100000000.0; // Prices and quantities journalled in 1e-8 ticks (off-grid values raw)
+
+    // 14. Matcher Pool (books spread over several matcher threads)
+    inline constexpr size_t   POOL_LANE_CAPACITY  = 1024; // Queued requests per book (power of two)
+    inline constexpr size_t   POOL_INBOX_CAPACITY = 256;  // Lanes in flight to one matcher (power of two)
+    inline constexpr size_t   POOL_BATCH          = 32;   // Requests served per lane visit; also the hand-over granularity
+    inline constexpr int      POOL_IDLE_US        = 20;   // Matcher back-off when none of its lanes has work
+    inline constexpr int      POOL_REBALANCE_MS   = 100;  // Load sampling / balancing period
+    inline constexpr uint64_t POOL_MIN_IMBALANCE  = 1000; // Requests per period between hottest and coldest before moving a lane
 }
 
 namespace Precision {
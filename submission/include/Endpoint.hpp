@@ -0,0 +1,26 @@
+#pragma once
+
+#include <charconv>
+#include <string>
+#include <string_view>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+
+// Parses "a.b.c.d:port" into 'out'; returns an error message, empty on success
+inline std::string parseEndpoint(std::string_view text, sockaddr_in& out, bool allowPortZero = false) {
+    size_t colon = text.rfind(':');
+    if (colon == std::string_view::npos) return "Expected host:port";
+    std::string host(text.substr(0, colon));
+    std::string_view portText = text.substr(colon + 1);
+    uint16_t port = 0;
+    auto [ptr, ec] = std::from_chars(portText.data(), portText.data() + portText.size(), port);
+    if (ec != std::errc() || ptr != portText.data() + portText.size() || (port == 0 && !allowPortZero)) {
+        return "Bad port";
+    }
+
+    out = {};
+    out.sin_family = AF_INET;
+    out.sin_port = htons(port);
+    if (::inet_pton(AF_INET, host.c_str(), &out.sin_addr) != 1) return "Bad IPv4 address";
+    return {};
+}
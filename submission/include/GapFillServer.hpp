@@ -0,0 +1,64 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "Constants.hpp"
+#include "Type.hpp"
+#include "MpscRing.hpp"
+
+class TradingEngine;
+
+struct GapFillReply {
+    SessionID session;
+    uint64_t fromSequence;
+    uint64_t toSequence;
+    std::vector<ExecutionReport> reports; // In sequence order, starting at fromSequence
+    bool complete;                        // False: the tail of the range has left the window
+};
+
+struct GapFillRequest {
+    SessionID session;
+    uint64_t fromSequence;
+    uint64_t toSequence;
+    std::function<void(GapFillReply&&)> reply; // Runs on the server thread
+};
+
+/**
+ * @brief Serves retransmission requests from the sessions' windows on its own thread.
+ *
+ * The matcher is never involved: replies are plain copies out of the RetransmitStore.
+ * Ranges larger than GAPFILL_MAX_MESSAGES are truncated (complete = false) and the client
+ * asks again from where the reply stopped.
+ *
+ * Library-only for now: kraken_submission enters every order anonymously (session 0) and
+ * opens no sessions, so it has nothing to serve. A front end that opens sessions starts one.
+ */
+class GapFillServer {
+public:
+    explicit GapFillServer(const TradingEngine& engine);
+    ~GapFillServer();
+
+    GapFillServer(const GapFillServer&) = delete;
+    GapFillServer& operator=(const GapFillServer&) = delete;
+
+    void start();
+    void stop(); // Serves whatever is queued, then joins
+
+    // Non-blocking; false if the request queue is full
+    bool request(GapFillRequest req) { return queue.tryPush(req); }
+
+    uint64_t getServed() const { return served.load(std::memory_order_relaxed); }
+
+private:
+    const TradingEngine& engine;
+    MpscRing<GapFillRequest, Config::GAPFILL_QUEUE_CAPACITY> queue;
+    std::thread server;
+    std::atomic<bool> running{false};
+    std::atomic<uint64_t> served{0};
+
+    void run();
+    bool serveOne();
+};
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Runs deferred maintenance in the gaps between inbound messages.
+ *
+ * Every task is a step function that performs one bounded slice of work and returns
+ * true while more work remains. The scheduler round-robins slices and checks the
+ * caller's yield predicate between every slice, so a new message waits at most one
+ * slice. Tasks must be safe to run on the matcher thread that owns the books.
+ */
+class IdleScheduler {
+public:
+    using Task = std::function<bool()>;
+
+    void addTask(std::string name, Task step);
+
+    /**
+     * Runs slices until 'budget' elapses, every task reports no work, or 'shouldYield'
+     * returns true. Returns the number of slices executed.
+     */
+    size_t runIdle(std::chrono::nanoseconds budget, const std::function<bool()>& shouldYield);
+
+    // True if the last idle period ended (budget or yield) before every task drained
+    bool hasPendingWork() const;
+
+    size_t getTaskCount() const { return tasks.size(); }
+
+private:
+    struct Entry {
+        std::string name;
+        Task step;
+        bool drained = false; // Reported no work during the current idle period
+    };
+
+    std::vector<Entry> tasks;
+    size_t cursor = 0; // Round-robin position survives across idle periods
+};
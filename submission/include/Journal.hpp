@@ -0,0 +1,146 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "Constants.hpp"
+#include "Type.hpp"
+
+enum class JournalRecordType : uint8_t { ORDER = 1, CANCEL = 2 };
+
+// One accepted request, decoded
+struct JournalRecord {
+    JournalRecordType type = JournalRecordType::ORDER;
+    OrderID orderId = 0;
+    // ORDER only
+    uint64_t timestamp = 0;
+    Symbol symbol;
+    Side side = Side::BUY;
+    OrderType orderType = OrderType::LIMIT;
+    PegType pegType = PegType::NONE;
+    double price = 0.0;
+    double quantity = 0.0;
+    double displayQuantity = 0.0;
+    SessionID session = 0;
+    std::string tag;
+};
+
+// Frames one block: the payload decodes on its own, so replay can start at any block
+struct JournalBlockHeader {
+    static constexpr uint32_t MAGIC = 0x4B4A4E32; // "KJN2"
+    uint32_t magic;
+    uint32_t payloadBytes;
+    uint32_t recordCount;
+    uint32_t checksum;    // FNV-1a over the payload; a mismatch marks a torn tail
+    uint64_t firstRecord; // Journal-wide index of the block's first record
+};
+
+/**
+ * @brief Append-only, compactly encoded log of accepted orders and cancels.
+ *
+ * Records are varint coded against per-block state: order ids and timestamps as deltas,
+ * symbols as interned ids (defined once per block), prices as tick deltas from the previous
+ * price in the same symbol, quantities in ticks, and tags front-coded against the previous
+ * tag. A price or quantity off the tick grid escapes to its raw bits, so replay is bit-exact.
+ *
+ * Records collect in an in-memory block. A full block is sealed and handed to a syncer thread,
+ * so the order that fills it never waits on the disk; commit() seals the open block too and
+ * waits until everything handed over is written and synced once (group commit). Block size
+ * bounds how far a reader decodes before reaching a seek target.
+ */
+class JournalWriter {
+public:
+    JournalWriter() = default;
+    ~JournalWriter();
+
+    JournalWriter(const JournalWriter&) = delete;
+    JournalWriter& operator=(const JournalWriter&) = delete;
+
+    // Opens for append after the last intact block (a torn tail is cut off). Error message or empty.
+    std::string open(const std::string& path);
+
+    void appendOrder(const Order& order);
+    void appendCancel(OrderID id);
+
+    // Seals the open block and waits until every sealed block is written and fdatasynced.
+    // Empty on success. On failure the file is cut back to its last intact block and the
+    // blocks are kept for the next commit to retry; the error stays latched until one succeeds.
+    std::string commit();
+    // Drops every record, buffered or written (session rollover)
+    void clear();
+
+    uint64_t getRecordCount() const { return nextRecord; }
+    uint64_t getBytesWritten() const { std::lock_guard lock(syncMutex); return bytesWritten; }
+    std::string getError() const { std::lock_guard lock(syncMutex); return error; }
+
+private:
+    int fd = -1;
+    std::string payload;
+    uint32_t blockRecords = 0;
+    uint64_t nextRecord = 0;
+
+    // Shared with the syncer thread, under syncMutex
+    mutable std::mutex syncMutex;
+    std::condition_variable syncWake;
+    std::condition_variable syncDone;
+    std::string sealed;          // Framed blocks not yet written, in journal order
+    bool syncing = false;        // The syncer is writing a batch taken from 'sealed'
+    bool stalled = false;        // The last batch failed; held until commit() asks for a retry
+    bool stopping = false;
+    uint64_t bytesWritten = 0;   // Intact prefix of the file
+    std::string error;
+    std::thread syncer;
+
+    // Per-block delta state; mirrored exactly by JournalReader
+    std::unordered_map<Symbol, std::pair<uint32_t, int64_t>> symbols; // id, last price in ticks
+    OrderID lastOrderId = 0;
+    uint64_t lastTimestamp = 0;
+    std::string lastTag;
+
+    void resetBlockState();
+    void endRecord();
+    void seal();
+    void syncLoop();
+};
+
+class JournalReader {
+public:
+    JournalReader() = default;
+    ~JournalReader();
+
+    JournalReader(const JournalReader&) = delete;
+    JournalReader& operator=(const JournalReader&) = delete;
+
+    std::string open(const std::string& path);
+
+    // Next record in journal order; false at the end or at the first damaged block
+    bool next(JournalRecord& out);
+
+    // Positions the reader on record 'index' by hopping block headers; false if past the end
+    bool seek(uint64_t index);
+
+    uint64_t getIntactBytes() const { return intactBytes; } // End of the last block that verified
+    uint64_t getRecordIndex() const { return recordIndex; } // Index of the record next() returns
+
+private:
+    int fd = -1;
+    uint64_t fileOffset = 0;  // Start of the next unread block
+    uint64_t intactBytes = 0;
+    uint64_t recordIndex = 0;
+
+    std::string payload;
+    size_t cursor = 0;
+    uint32_t recordsLeft = 0;
+
+    std::vector<std::pair<Symbol, int64_t>> symbols; // By interned id: symbol, last price in ticks
+    OrderID lastOrderId = 0;
+    uint64_t lastTimestamp = 0;
+    std::string lastTag;
+
+    bool loadBlock(bool decode);
+};
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+
+/**
+ * @brief Log2-bucketed latency histogram: O(1) record, fixed 65 counters, no allocation.
+ *
+ * Bucket b counts values in [2^(b-1), 2^b) ns (bucket 0 counts 0), so a percentile is known
+ * to within a factor of two: enough to see where the outliers sit. One writer; readers on
+ * other threads see a slightly stale but consistent-enough view.
+ */
+class LatencyHistogram {
+public:
+    static constexpr size_t BUCKETS = 65;
+
+    void record(uint64_t ns) {
+        buckets[std::bit_width(ns)].fetch_add(1, std::memory_order_relaxed);
+        count.fetch_add(1, std::memory_order_relaxed);
+        if (ns > max.load(std::memory_order_relaxed)) max.store(ns, std::memory_order_relaxed);
+    }
+
+    uint64_t getCount() const { return count.load(std::memory_order_relaxed); }
+    uint64_t getMax() const { return max.load(std::memory_order_relaxed); }
+
+    // Upper bound (ns) of the bucket holding quantile 'q' in [0, 1]; 0 when empty
+    uint64_t percentile(double q) const {
+        uint64_t total = getCount();
+        if (total == 0) return 0;
+        auto rank = static_cast<uint64_t>(q * static_cast<double>(total - 1)) + 1;
+        uint64_t seen = 0;
+        for (size_t b = 0; b < BUCKETS; ++b) {
+            seen += buckets[b].load(std::memory_order_relaxed);
+            if (seen >= rank) return std::min(upperBound(b), getMax());
+        }
+        return getMax();
+    }
+
+private:
+    std::array<std::atomic<uint64_t>, BUCKETS> buckets{};
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> max{0};
+
+    static uint64_t upperBound(size_t bucket) {
+        return (bucket >= 64) ? UINT64_MAX : (uint64_t{1} << bucket) - 1;
+    }
+};
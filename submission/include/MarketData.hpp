@@ -0,0 +1,81 @@
+#pragma once
+
+#include <atomic>
+
+#include "Constants.hpp"
+#include "Type.hpp"
+#include "RetransmitStore.hpp"
+
+enum class MarketDataKind : uint8_t { LEVEL, TRADE };
+
+// One L2 change or one trade of one book; trivially copyable, sent on the wire as is.
+// Alignment gaps are spelled out as zeroed members so no stack or heap bytes leave the host.
+struct MarketDataEvent {
+    SeqNum sequence;     // Per book, first = 1; a jump is a gap
+    MarketDataKind kind;
+    uint8_t reserved0[3]{};
+    Side side;           // LEVEL: ladder side; TRADE: aggressor side
+    Symbol symbol;
+    uint8_t reserved1[4]{};
+    double price;
+    double quantity;     // LEVEL: new displayed volume at 'price' (0 = level gone); TRADE: size
+};
+static_assert(sizeof(MarketDataEvent) == sizeof(SeqNum) + sizeof(MarketDataKind) + 3 + sizeof(Side)
+              + sizeof(Symbol) + 4 + 2 * sizeof(double), "MarketDataEvent must have no implicit padding");
+
+/**
+ * @brief Broadcast ring of one book's L2/trade events.
+ *
+ * Written once by the book's matcher; any number of MarketDataCursors read it without
+ * copying per subscriber and without the writer knowing they exist. The writer never
+ * waits: a reader that falls more than MD_RING_CAPACITY events behind is lapped and must
+ * resync from a snapshot (OrderBookSnapshot::marketDataSeq tells it where to resume).
+ */
+class MarketDataRing {
+public:
+    void publish(MarketDataKind kind, Side side, const Symbol& symbol, double price, double quantity) {
+        SeqNum seq = lastSequence.load(std::memory_order_relaxed) + 1;
+        events.write(seq, {.sequence = seq, .kind = kind, .side = side, .symbol = symbol,
+                           .price = price, .quantity = quantity});
+        lastSequence.store(seq, std::memory_order_release);
+    }
+
+    SeqNum getLastSequence() const { return lastSequence.load(std::memory_order_acquire); }
+
+    // False if 'seq' is not published yet or has already been overwritten
+    bool read(SeqNum seq, MarketDataEvent& out) const {
+        return seq <= getLastSequence() && events.read(seq, out);
+    }
+
+private:
+    RetransmitStore<MarketDataEvent, Config::MD_RING_CAPACITY> events;
+    std::atomic<SeqNum> lastSequence{0};
+};
+
+enum class CursorStatus : uint8_t { OK, EMPTY, LAPPED };
+
+// One subscriber's independent read position in a MarketDataRing
+class MarketDataCursor {
+public:
+    // Starts at the oldest event ever published (1) or just after the newest one
+    explicit MarketDataCursor(const MarketDataRing& ring, bool fromStart = true)
+        : ring(&ring), next(fromStart ? 1 : ring.getLastSequence() + 1) {}
+
+    CursorStatus poll(MarketDataEvent& out) {
+        if (next > ring->getLastSequence()) return CursorStatus::EMPTY;
+        if (!ring->read(next, out)) return CursorStatus::LAPPED; // Stays lapped until resync()
+        ++next;
+        return CursorStatus::OK;
+    }
+
+    // Skips to the live edge (or to just after 'snapshotSeq', taken from a book snapshot)
+    void resync() { next = ring->getLastSequence() + 1; }
+    void resync(SeqNum snapshotSeq) { next = snapshotSeq + 1; }
+
+    const MarketDataRing* getRing() const { return ring; }
+    SeqNum getNextSequence() const { return next; }
+
+private:
+    const MarketDataRing* ring;
+    SeqNum next;
+};
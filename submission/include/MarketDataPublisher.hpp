@@ -0,0 +1,89 @@
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#include "Constants.hpp"
+#include "MarketData.hpp"
+
+class TradingEngine;
+
+// Datagram layout: one header followed by 'count' raw MarketDataEvent records
+struct MarketDataPacketHeader {
+    static constexpr uint32_t MAGIC = 0x4B4D4431; // "KMD1"
+    uint32_t magic;
+    uint16_t count;
+    uint16_t eventSize;      // sizeof(MarketDataEvent), so receivers can reject a layout change
+    uint64_t packetSequence; // Per publisher, first = 1; detects datagram loss on the wire
+};
+static_assert(sizeof(MarketDataPacketHeader) == 16, "Every header byte is a field that seal() writes");
+static_assert(sizeof(MarketDataPacketHeader) + Config::MD_EVENTS_PER_DATAGRAM * sizeof(MarketDataEvent)
+              <= Config::MD_MAX_DATAGRAM, "A full batch must fit one unfragmented datagram");
+
+/**
+ * @brief Fans the books' L2/trade events out over UDP.
+ *
+ * Runs on its own thread and follows every book's broadcast ring with its own cursor, never
+ * touching the shadows or the live ladder. Events are packed MD_EVENTS_PER_DATAGRAM to a datagram and every datagram
+ * goes to every endpoint, up to MD_DATAGRAMS_PER_SEND datagrams per sendmmsg() call.
+ * Endpoints are IPv4 unicast (loopback/local) or multicast groups, looped back locally.
+ * If the publisher is lapped it skips to the live edge; receivers see the per-book
+ * sequence jump and resync from a snapshot.
+ */
+class MarketDataPublisher {
+public:
+    explicit MarketDataPublisher(const TradingEngine& engine);
+    ~MarketDataPublisher();
+
+    MarketDataPublisher(const MarketDataPublisher&) = delete;
+    MarketDataPublisher& operator=(const MarketDataPublisher&) = delete;
+
+    // "a.b.c.d:port"; returns an error message, empty on success. Before start() only.
+    std::string addEndpoint(std::string_view endpoint);
+
+    void start();
+    void stop(); // Sends whatever is queued, then joins
+
+    uint64_t getEventsSent() const { return eventsSent.load(std::memory_order_relaxed); }
+    uint64_t getDatagramsSent() const { return datagramsSent.load(std::memory_order_relaxed); }
+    uint64_t getSendErrors() const { return sendErrors.load(std::memory_order_relaxed); }
+    uint64_t getLaps() const { return laps.load(std::memory_order_relaxed); }
+
+private:
+    struct Datagram {
+        MarketDataPacketHeader header;
+        MarketDataEvent events[Config::MD_EVENTS_PER_DATAGRAM];
+
+        size_t size() const { return sizeof(header) + header.count * sizeof(MarketDataEvent); }
+    };
+
+    const TradingEngine& engine;
+    int socketFd = -1;
+    std::vector<sockaddr_in> endpoints;
+
+    // Publisher thread only
+    std::vector<MarketDataCursor> cursors; // One per book, in discovery order
+    std::vector<Datagram> batch; // Sealed datagrams plus the one being filled
+    std::vector<iovec> iovs;     // One per (datagram, endpoint), sized in start()
+    std::vector<mmsghdr> msgs;
+    size_t sealed = 0;
+    uint64_t nextPacketSequence = 0;
+
+    std::thread publisher;
+    std::atomic<bool> running{false};
+    std::atomic<uint64_t> eventsSent{0};
+    std::atomic<uint64_t> datagramsSent{0};
+    std::atomic<uint64_t> sendErrors{0};
+    std::atomic<uint64_t> laps{0};
+
+    void run();
+    void discoverBooks(); // Adds a cursor for every book that gained a ring since the last call
+    size_t pump();     // One pass over every ring; returns events taken
+    void seal();       // Closes the datagram being filled
+    void sendBatch();  // Hands every sealed datagram to sendmmsg()
+};
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+#include "Constants.hpp"
+#include "Type.hpp"
+#include "MpscRing.hpp"
+
+class TradingEngine;
+
+// Symbol routes it to the owning matcher; an order in any other book is rejected, not cancelled
+struct CancelRequest { OrderID orderId; Symbol symbol; };
+
+using MatcherRequest = std::variant<LimitOrderRequest, MarketOrderRequest, IcebergOrderRequest,
+                                    PeggedOrderRequest, CancelRequest>;
+
+struct MatcherTask {
+    MatcherRequest request;
+    std::function<void(EngineResponse&&)> reply; // Runs on the matcher thread; may be empty
+};
+
+/**
+ * @brief Matches books on several threads, each book owned by exactly one of them.
+ *
+ * Every book has its own ingress ring (a lane). A matcher thread serves the lanes it owns,
+ * so books never need a lock and requests for one book stay in arrival order. The balancer
+ * samples per-lane request counts every POOL_REBALANCE_MS and, when one matcher carries
+ * clearly more than another, moves a lane from the hottest to the coldest. The hand-over
+ * happens at a safe point between two batches: the old owner finishes its batch, stops
+ * serving the lane and passes it (ring included, nothing dropped or reordered) to the new
+ * owner's inbox. Other lanes keep running throughout.
+ *
+ * The persistent store, the journal and warmBooks() assume a single matcher and must not
+ * be used while a pool runs: start() refuses an engine with a store or journal attached.
+ */
+class MatcherPool {
+public:
+    MatcherPool(TradingEngine& engine, size_t threads);
+    ~MatcherPool();
+
+    MatcherPool(const MatcherPool&) = delete;
+    MatcherPool& operator=(const MatcherPool&) = delete;
+
+    bool start(); // False (nothing started) if the engine has a store or journal
+    void stop(); // Serves whatever is queued, then joins
+
+    // Non-blocking; false if the book's lane is full
+    bool submit(MatcherTask task);
+
+    /**
+     * One balancing round over the load seen since the previous round: moves at most one
+     * lane and returns true if it did. Called by the balancer thread; public for tests.
+     */
+    bool rebalance();
+
+    size_t getThreadCount() const { return matchers.size(); }
+    // Matcher currently serving 'symbol' (or about to, if a move is pending); -1 if unknown
+    int getOwner(const Symbol& symbol) const;
+    uint64_t getProcessed(const Symbol& symbol) const;
+    uint64_t getMigrations() const { return migrations.load(std::memory_order_relaxed); }
+
+private:
+    struct Lane {
+        Symbol symbol;
+        MpscRing<MatcherTask, Config::POOL_LANE_CAPACITY> ring;
+        std::atomic<size_t> owner;            // Matcher that last adopted the lane
+        std::atomic<size_t> target;           // != owner: a hand-over is pending
+        std::atomic<uint64_t> processed{0};   // Load counter, sampled by rebalance()
+        uint64_t sampled = 0;                 // rebalance() only
+
+        Lane(const Symbol& sym, size_t home) : symbol(sym), owner(home), target(home) {}
+    };
+
+    struct Matcher {
+        MpscRing<Lane*, Config::POOL_INBOX_CAPACITY> inbox; // Lanes handed to this matcher
+        std::vector<Lane*> lanes;                            // Owning thread only; it alone pops their rings
+        std::thread thread;
+    };
+
+    TradingEngine& engine;
+    std::vector<std::unique_ptr<Matcher>> matchers;
+    std::unordered_map<Symbol, std::unique_ptr<Lane>> lanes;
+    mutable std::shared_mutex laneMutex;
+    std::thread balancer;
+    std::mutex balanceMutex; // One rebalance() round at a time
+    std::atomic<bool> running{false};
+    std::atomic<uint64_t> migrations{0};
+    size_t nextHome = 0; // Round-robin placement of new lanes; guarded by laneMutex
+
+    Lane* laneFor(const Symbol& symbol);
+    void handOver(Lane* lane, size_t to);
+    size_t serveLane(Lane& lane);
+    void runMatcher(size_t index);
+    void runBalancer();
+};
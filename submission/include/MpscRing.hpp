@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ * @brief Bounded lock-free multi-producer / single-consumer ring (Vyukov sequence cells).
+ *
+ * Producers claim a slot with one CAS on 'tail' and publish it by bumping the cell's
+ * sequence; they never block and never wait for the consumer: a full ring makes tryPush()
+ * fail and the caller decides what a drop means. Only one thread may call tryPop().
+ */
+template<typename T, size_t Capacity>
+class MpscRing {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    MpscRing() : cells(std::make_unique<Cell[]>(Capacity)) {
+        for (size_t i = 0; i < Capacity; ++i) cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    MpscRing(const MpscRing&) = delete;
+    MpscRing& operator=(const MpscRing&) = delete;
+
+    bool tryPush(const T& value) {
+        size_t pos = tail.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells[pos & MASK];
+            size_t seq = cell.sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.value = value;
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false; // Full: the consumer has not freed this cell yet
+            } else {
+                pos = tail.load(std::memory_order_relaxed); // Another producer took it
+            }
+        }
+    }
+
+    // Consumer thread only
+    bool tryPop(T& out) {
+        Cell& cell = cells[head & MASK];
+        size_t seq = cell.sequence.load(std::memory_order_acquire);
+        if (static_cast<intptr_t>(seq) - static_cast<intptr_t>(head + 1) < 0) return false;
+        out = cell.value;
+        cell.sequence.store(head + Capacity, std::memory_order_release);
+        ++head;
+        return true;
+    }
+
+    static constexpr size_t capacity() { return Capacity; }
+
+private:
+    static constexpr size_t MASK = Capacity - 1;
+
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    alignas(64) std::atomic<size_t> tail{0}; // Shared by producers
+    alignas(64) size_t head = 0;             // Private to the consumer
+};
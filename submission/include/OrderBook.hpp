@@ -9,19 +9,35 @@
 #include <optional>
 #include <unordered_map>
 #include <mutex>
+#include <bit>
+#include <array>
 
 #include "Constants.hpp"
 #include "Type.hpp" 
+#include "MarketData.hpp"
+#include "SnapshotRender.hpp"
 
 class OrderBook {
 public:
     // Updated: Uses Symbol struct
-    explicit OrderBook(Symbol sym);
+    // 'epochClock' is the engine-wide publish counter shared by all books
+    OrderBook(Symbol sym, std::atomic<SeqNum>& epochClock);
 
     // Updated: nextExecId now uses ExecID (uint64_t)
     MatchResult execute(std::shared_ptr<Order> taker, std::atomic<ExecID>& nextExecId);
 
     [[nodiscard]] OrderBookSnapshot getSnapshot(size_t depth) const;
+
+    // The current version rendered as 'format'. Repeated calls between updates share one
+    // immutable buffer; a newer version is rendered on first request (lazy invalidation).
+    [[nodiscard]] std::shared_ptr<const std::string> getRenderedSnapshot(size_t depth, SnapshotFormat format) const;
+
+    // Depth aggregated into 'bucketSize' price bands (bids floor, asks ceil); nullopt if that
+    // size is not one of Config::DEPTH_BUCKET_SIZES
+    [[nodiscard]] std::optional<OrderBookSnapshot> getGroupedSnapshot(double bucketSize, size_t depth) const;
+
+    // Newest published version whose epoch is <= 'epoch'; nullopt if it has already been recycled
+    [[nodiscard]] std::optional<OrderBookSnapshot> getSnapshotAt(SeqNum epoch, size_t depth) const;
     
     // Updated: Takes OrderID (uint64_t)
     [[nodiscard]] std::optional<double> getRemainingQty(OrderID id) const;
@@ -29,6 +45,30 @@ public:
     // Updated: Takes OrderID (uint64_t)
     std::optional<double> cancelById(OrderID id);
 
+    [[nodiscard]] BookDigest getDigest() const;
+
+    // Displayed/hidden split and time priority of a resting order; nullopt if not on the book
+    [[nodiscard]] std::optional<RestingState> getRestingState(OrderID id) const;
+
+    // Puts resting orders on the book in one sort plus one linear pass (checkpoint restore,
+    // opening seeds): queues follow state.priority, so persisted orders come back exactly as
+    // they rested. Entries must not cross each other or the book. Publishes once.
+    // Caller guarantees no matching is in flight on this book.
+    void bulkLoad(std::vector<RestingEntry> entries);
+
+    // Touches the best levels and their head orders so the next match finds them in cache.
+    // Reads live structures: matcher thread only.
+    void warmTopOfBook() const;
+
+    // Starts emitting L2 level changes and trades into this book's broadcast ring (idempotent).
+    // Caller guarantees no matching is in flight on this book.
+    const MarketDataRing* enableMarketData();
+    const MarketDataRing* getMarketData() const { return marketData.get(); }
+
+    // Session rollover: drops every resting order but keeps ladder, shadow and index capacity.
+    // Caller guarantees no matching is in flight on this book.
+    void reset();
+
     double getLastPrice() const { 
         return lastMatchedPrice.load(std::memory_order_relaxed); 
     }
@@ -37,6 +77,11 @@ public:
         return bids.size() + asks.size();
     }
 
+    // Resting orders, ladder and pegged
+    size_t getOrderCount() const {
+        return idToLocation.size();
+    }
+
 private:
     Symbol symbol; // Correctly uses the Symbol struct
     std::atomic<double> lastMatchedPrice{0.0};
@@ -52,23 +97,137 @@ private:
     // Helper to binary search the correct price level
     auto findLevel(std::vector<PriceLevel>& side, double price, Side orderSide);
 
+    // Monotonic time priority source shared by ladder and pegged entries
+    SeqNum nextPriority = 0;
+
+    // Additive (mod 2^64) sum of entryDigest() over all resting entries; O(1) per mutation
+    uint64_t bookDigest = 0;
+
+    // Hashes the replicated state of one entry. The stored order price is used (0.0 for pegs),
+    // never the execution price, so the contribution does not depend on the BBO.
+    static uint64_t entryDigest(const OrderEntry& entry) {
+        auto mix = [](uint64_t x) {
+            x += 0x9e3779b97f4a7c15ULL;
+            x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+            return x ^ (x >> 31);
+        };
+        uint64_t h = mix(entry.fatOrder->orderID);
+        h = mix(h ^ std::bit_cast<uint64_t>(entry.fatOrder->price));
+        h = mix(h ^ std::bit_cast<uint64_t>(entry.remainingQuantity));
+        return mix(h ^ std::bit_cast<uint64_t>(entry.hiddenQuantity));
+    }
+
     // SHADOW BUFFER
+    // A small ring of published versions: readers take the head, epoch cuts may take an older one.
+    // Epochs are drawn while holding shadowMutex, so a reader that locks the book after reading
+    // epoch E either sees every version <= E or blocks until it is published.
+    std::atomic<SeqNum>& epochClock;
     mutable std::shared_mutex shadowMutex;
-    ShadowBuffer shadow;
+    std::array<ShadowBuffer, Config::SHADOW_VERSIONS> shadows;
+    size_t shadowHead = 0;
+
+    OrderBookSnapshot snapshotFrom(const ShadowBuffer& shadow, size_t depth) const;
+
+    // RENDER CACHE: a few (format, depth) renderings, each valid for exactly one shadow sequence.
+    // Lock order: shadowMutex before renderMutex.
+    struct RenderedSnapshot {
+        SeqNum updateSeq = 0;
+        size_t depth = 0;
+        SnapshotFormat format = SnapshotFormat::TEXT;
+        std::shared_ptr<const std::string> bytes; // Null = free slot
+    };
+    mutable std::shared_mutex renderMutex;
+    mutable std::array<RenderedSnapshot, Config::RENDER_CACHE_SLOTS> renderCache;
+
+    // GROUPED DEPTH: bucket index -> displayed volume, per side and per configured bucket size.
+    // Fed by every PriceLevel::totalVolume change, so it is never rebuilt from the ladder; a
+    // bucket is erased once it empties, as a level is. Ordered, so a publish reads the best
+    // MAX_GROUPED_DEPTH straight off the map, and only when a change reached them.
+    struct BucketLadder {
+        std::map<int64_t, double> volumes;
+        bool dirty = false;                     // The published window changed since the last publish
+        std::optional<int64_t> worstPublished;  // Last published bucket, while the window is full
+    };
+    std::array<BucketLadder, Config::DEPTH_BUCKET_SIZES.size()> bidBuckets;
+    std::array<BucketLadder, Config::DEPTH_BUCKET_SIZES.size()> askBuckets;
+
+    static int64_t bucketIndex(double price, double bucketSize, Side side) {
+        // Bids round down, asks round up, so a band never advertises a better price than it holds
+        double scaled = price / bucketSize;
+        return static_cast<int64_t>((side == Side::BUY) ? std::floor(scaled + Precision::EPSILON)
+                                                        : std::ceil(scaled - Precision::EPSILON));
+    }
+
+    // The single place a level's displayed volume changes; keeps the buckets in step in O(1)
+    // and reports the new level volume to the market-data ring
+    void adjustLevelVolume(Side side, PriceLevel& level, double delta);
+
+    std::unique_ptr<MarketDataRing> marketData; // Null until enabled: no event cost by default
+
+    // PEGGED VENUE (not displayed in snapshots)
+    PeggedQueue peggedBids;
+    PeggedQueue peggedAsks;
+
+    // Existing level at 'price' or a new one inserted in ladder order
+    std::vector<PriceLevel>::iterator levelFor(Side side, double price);
 
     void placeOrder(std::shared_ptr<Order> order);
+    void placePegged(std::shared_ptr<Order> order);
     void publishShadow(); 
 
+    // Derived on demand from the ladder BBO; nullopt while the reference price does not exist
+    std::optional<double> effectivePegPrice(PegType peg, Side restingSide) const;
+
+    // An arriving mid peg against the opposite mid lane, at the midpoint; the ladder is untouched
+    void matchMidPegs(Order& taker, MatchResult& result, std::atomic<ExecID>& nextExecId);
+
+    // Reloads the next iceberg slice and moves the same node to the level tail in O(1)
+    void replenishIceberg(PriceLevel& level, std::list<OrderEntry>::iterator entryIt);
+
+    // Trades 'taker' against one resting entry at 'price'; returns the matched quantity
+    double fillEntry(OrderEntry& entry, double price, Order& taker,
+                     MatchResult& result, std::atomic<ExecID>& nextExecId);
+
     // Internal Template - Updated to use ExecID
+    // Walks the ladder and the opposite pegged queue as one price-time ordered stream:
+    // at every step the better effective price wins, and on a price tie the older order does.
     template<typename SideVector>
-    void matchAgainstBook(SideVector& targetSide, std::shared_ptr<Order> taker, 
+    void matchAgainstBook(SideVector& targetSide, PeggedQueue& pegs, std::shared_ptr<Order> taker, 
                         MatchResult& result, std::atomic<ExecID>& nextExecId) {
 
-        auto it = targetSide.begin();
-        
-        // Use the helper for consistency
-        while (it != targetSide.end() && Precision::isPositive(taker->remainingQuantity)) {
-            double levelPrice = it->price;
+        const Side restingSide = (taker->side == Side::BUY) ? Side::SELL : Side::BUY;
+
+        while (Precision::isPositive(taker->remainingQuantity)) {
+            // 1. Best pegged candidate: a mid peg always prices at or through a primary peg
+            std::list<OrderEntry>* pegLane = nullptr;
+            double pegPrice = 0.0;
+            for (PegType peg : {PegType::MID, PegType::PRIMARY}) {
+                auto& lane = pegs.lane(peg);
+                if (lane.empty()) continue;
+                if (auto px = effectivePegPrice(peg, restingSide)) {
+                    pegLane = &lane;
+                    pegPrice = *px;
+                    break;
+                }
+            }
+
+            // 2. Merge with the ladder by effective price, then by arrival
+            auto it = targetSide.begin();
+            bool takePeg = false;
+            if (pegLane) {
+                if (it == targetSide.end()) {
+                    takePeg = true;
+                } else if (Precision::equal(pegPrice, it->price)) {
+                    takePeg = pegLane->front().priority < it->entries.front().priority;
+                } else {
+                    takePeg = (restingSide == Side::SELL) ? (pegPrice < it->price) : (pegPrice > it->price);
+                }
+            } else if (it == targetSide.end()) {
+                break;
+            }
+
+            double levelPrice = takePeg ? pegPrice : it->price;
 
             if (taker->type == OrderType::LIMIT) {
                 if (taker->side == Side::BUY) {
@@ -78,48 +237,26 @@ private:
                 }
             }
 
-            PriceLevel& level = *it;
-            auto entryIt = level.entries.begin();
-
-            while (entryIt != level.entries.end() && Precision::isPositive(taker->remainingQuantity)) {
-                double matchQty = std::min(taker->remainingQuantity, entryIt->remainingQuantity);
-                
-                result.fills.push_back({
-                    nextExecId.fetch_add(1, std::memory_order_relaxed),
-                    levelPrice, matchQty, taker->orderID, entryIt->fatOrder->orderID
-                });
-
-                {
-                    std::unique_lock lock(entryIt->fatOrder->stateMutex);
-                    // Use subtract_or_zero to prevent drift
-                    Precision::subtract_or_zero(entryIt->remainingQuantity, matchQty);
-                    Precision::subtract_or_zero(entryIt->fatOrder->remainingQuantity, matchQty);
-                    entryIt->fatOrder->cumulativeCost += (matchQty * levelPrice);
-                    
-                    if (Precision::isZero(entryIt->remainingQuantity)) {
-                        entryIt->fatOrder->status = OrderStatus::FILLED;
-                        entryIt->fatOrder->remainingQuantity = 0.0; // Hard zero
-                    }
-                }
+            auto& queue = takePeg ? *pegLane : it->entries;
+            auto entryIt = queue.begin();
+            double matchQty = fillEntry(*entryIt, levelPrice, *taker, result, nextExecId);
 
-                Precision::subtract_or_zero(taker->remainingQuantity, matchQty);
-                taker->cumulativeCost += (matchQty * levelPrice);
-                Precision::subtract_or_zero(level.totalVolume, matchQty);
+            if (!takePeg) adjustLevelVolume(restingSide, *it, -matchQty);
+            lastMatchedPrice.store(levelPrice, std::memory_order_relaxed);
+            if (marketData) marketData->publish(MarketDataKind::TRADE, taker->side, symbol, levelPrice, matchQty);
 
-                if (Precision::isZero(entryIt->remainingQuantity)) {
-                    idToLocation.erase(entryIt->fatOrder->orderID);
-                    entryIt = level.entries.erase(entryIt);
+            if (Precision::isZero(entryIt->remainingQuantity)) {
+                if (!takePeg && Precision::isPositive(entryIt->hiddenQuantity)) {
+                    replenishIceberg(*it, entryIt);
                 } else {
-                    ++entryIt;
+                    bookDigest -= entryDigest(*entryIt);
+                    idToLocation.erase(entryIt->fatOrder->orderID);
+                    queue.erase(entryIt);
                 }
             }
 
-            lastMatchedPrice.store(levelPrice, std::memory_order_relaxed);
-
-            if (level.entries.empty()) {
-                it = targetSide.erase(it);
-            } else {
-                break; 
+            if (!takePeg && it->entries.empty()) {
+                targetSide.erase(it);
             }
         }
     }
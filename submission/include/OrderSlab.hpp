@@ -0,0 +1,138 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include <atomic>
+#include <vector>
+
+#include "Type.hpp"
+
+/**
+ * @brief POD image of one order, addressed by slot index and never by pointer,
+ * so the mapping means the same thing to the next process that attaches it.
+ */
+struct SlabRecord {
+    OrderID orderID;
+    uint64_t timestamp;
+    SeqNum priority;           // Book time priority: restores FIFO order exactly
+    double price;
+    double originalQuantity;
+    double remainingQuantity;
+    double displayed;          // Resting displayed slice (0.0 once terminal)
+    double hidden;             // Iceberg reserve
+    double displayQuantity;
+    double cumulativeCost;
+    SessionID session;
+    uint32_t nextFree;         // Free-list link while the slot is unused
+    uint8_t inUse;
+    uint8_t side;
+    uint8_t type;
+    uint8_t status;
+    uint8_t pegType;
+    char symbol[Config::SYMBOL_LENGTH];
+    char tag[Config::MAX_TAG_SIZE + 1];
+};
+static_assert(std::is_trivially_copyable_v<SlabRecord>);
+
+struct SlabHeader {
+    uint64_t magic;
+    uint32_t layoutVersion;
+    uint32_t recordSize;
+    uint64_t capacity;
+    uint32_t highWater;        // Slots [0, highWater) have been handed out at least once
+    uint32_t freeHead;
+    SeqNum commitSequence;     // Odd while a request is being written through; /2 = requests persisted
+    OrderID nextOrderId;
+    ExecID nextExecId;
+};
+static_assert(std::is_trivially_copyable_v<SlabHeader>);
+
+// Undo log of the request being written: the allocation state at beginWrite() plus the
+// pre-image of every slot it has staged since. A crash mid-request replays the log backwards,
+// so the request is either wholly in the file or not at all.
+struct SlabUndo {
+    uint32_t count;            // Entries complete; an entry counts only once it is fully written
+    uint32_t highWater;
+    uint32_t freeHead;
+    uint32_t clearing;         // clear() is rolled forward rather than back
+};
+static_assert(std::is_trivially_copyable_v<SlabUndo>);
+
+struct SlabUndoEntry {
+    uint32_t slot;
+    SlabRecord image;
+};
+static_assert(std::is_trivially_copyable_v<SlabUndoEntry>);
+
+/**
+ * @brief A fixed-capacity array of SlabRecords in a MAP_SHARED file mapping.
+ *
+ * The page cache outlives the process, so a crash loses nothing already written; flush()
+ * pushes pages towards the disk for power loss. Single writer (the matcher thread).
+ */
+class OrderSlab {
+public:
+    static constexpr uint32_t NO_SLOT = UINT32_MAX;
+    static constexpr uint64_t MAGIC = 0x4B52414B534C4142ULL; // "KRAKSLAB"
+    static constexpr uint32_t LAYOUT_VERSION = 4;
+
+    OrderSlab() = default;
+    ~OrderSlab();
+    OrderSlab(const OrderSlab&) = delete;
+    OrderSlab& operator=(const OrderSlab&) = delete;
+
+    // Creates the file or reattaches to an existing one. Returns an error message on failure
+    // (layout mismatch, capacity mismatch, I/O), empty on success. A request cut off by a
+    // crash is closed on attach (wasRepaired()): every record it touched is rolled back, so
+    // a multi-order execution is restored whole or not at all.
+    std::string open(const std::string& path, size_t capacity);
+    bool wasRepaired() const { return repaired; }
+
+    uint32_t allocate();                    // NO_SLOT when full; stages the slot itself
+    void release(uint32_t slot);
+    void clear();                           // Frees every slot; header counters are kept. Alone in its bracket
+
+    SlabRecord& at(uint32_t slot) { return records[slot]; }
+    const SlabRecord& at(uint32_t slot) const { return records[slot]; }
+    SlabHeader& header() { return *head; }
+
+    // Brackets the record writes of one request, so a crash mid-request is undone on attach
+    void beginWrite() {
+        undo->count = 0;
+        undo->clearing = 0;
+        undo->highWater = head->highWater;
+        undo->freeHead = head->freeHead;
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+        ++head->commitSequence;
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+    }
+    void endWrite() {
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+        ++head->commitSequence;
+    }
+    // Inside a bracket, before changing a slot: logs its pre-image (once per slot per request)
+    void stage(uint32_t slot);
+
+    uint32_t getHighWater() const { return head->highWater; }
+    bool isFull() const { return head->freeHead == NO_SLOT && head->highWater == head->capacity; }
+    size_t getFreeSlots() const { return head->capacity - live; }
+
+    // Asynchronous writeback of dirty pages; cheap enough for an idle slice
+    void flush();
+
+private:
+    void* base = nullptr;
+    size_t mappedBytes = 0;
+    int fd = -1;
+    SlabHeader* head = nullptr;
+    SlabUndo* undo = nullptr;
+    SlabRecord* records = nullptr;
+    SlabUndoEntry* undoEntries = nullptr;  // capacity entries: a request stages each slot at most once
+    std::vector<SeqNum> stagedIn;          // Bracket that last staged each slot; not stored in the file
+    size_t live = 0; // Slots in use; recounted on open, not stored in the file
+    bool repaired = false;
+
+    void close();
+};
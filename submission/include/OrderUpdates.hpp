@@ -0,0 +1,59 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <variant>
+
+#include "Constants.hpp"
+#include "Type.hpp"
+#include "MpscRing.hpp"
+
+enum class OrderUpdateKind : uint8_t { ACK, PARTIAL_FILL, FILL, CANCEL };
+
+// One state transition of one order, as it happens
+struct OrderUpdate {
+    OrderUpdateKind kind;
+    OrderID orderId;
+    SessionID session;
+    Symbol symbol;
+    Side side;
+    ExecID executionId;    // Fills only
+    double lastPrice;      // Fills only
+    double lastQuantity;   // Fills only
+    double leavesQuantity; // Still open after this transition (cancelled quantity for CANCEL)
+};
+
+using SubscriptionID = uint64_t;
+
+// Which orders a subscriber hears about
+struct SubscriptionFilter {
+    std::variant<std::monostate, SessionID, Symbol> scope; // monostate = every order
+
+    static SubscriptionFilter all() { return {}; }
+    static SubscriptionFilter forSession(SessionID session) { return {session}; }
+    static SubscriptionFilter forSymbol(const Symbol& symbol) { return {symbol}; }
+};
+
+using OrderUpdateCallback = std::function<void(const OrderUpdate&)>;
+
+/**
+ * @brief Subscriber-owned ring for updates consumed on another thread. Never blocks the
+ * engine: a full queue drops and counts.
+ */
+class OrderUpdateQueue {
+public:
+    bool publish(const OrderUpdate& update) {
+        if (ring.tryPush(update)) return true;
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // Consumer thread only
+    bool poll(OrderUpdate& out) { return ring.tryPop(out); }
+
+    uint64_t getDropped() const { return dropped.load(std::memory_order_relaxed); }
+
+private:
+    MpscRing<OrderUpdate, Config::UPDATE_QUEUE_CAPACITY> ring;
+    std::atomic<uint64_t> dropped{0};
+};
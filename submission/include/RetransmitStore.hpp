@@ -0,0 +1,69 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <sys/mman.h>
+
+/**
+ * @brief Bounded window of the last 'Capacity' messages of one sequenced stream.
+ *
+ * Message 'seq' (starting at 1) lives in slot seq % Capacity, guarded by a per-slot seqlock
+ * stamp: 2*seq-1 while it is being written, 2*seq once complete. Writers never wait on
+ * readers; a reader that races an overwrite sees a different stamp and reports a miss
+ * instead of a torn copy. The slots are an anonymous mapping, so pages are only committed
+ * as the window fills.
+ */
+template<typename T, size_t Capacity>
+class RetransmitStore {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+    static_assert(std::is_trivially_copyable_v<T>, "Messages are copied with memcpy");
+
+public:
+    RetransmitStore() {
+        void* mem = ::mmap(nullptr, BYTES, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (mem == MAP_FAILED) throw std::bad_alloc();
+        slots = static_cast<Slot*>(mem); // Zero-filled: every stamp starts as "empty"
+    }
+    ~RetransmitStore() { ::munmap(slots, BYTES); }
+
+    RetransmitStore(const RetransmitStore&) = delete;
+    RetransmitStore& operator=(const RetransmitStore&) = delete;
+
+    // Concurrent writers are fine as long as they write distinct sequences
+    void write(uint64_t seq, const T& message) {
+        Slot& slot = slots[seq & MASK];
+        slot.stamp.store(2 * seq - 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(&slot.message, &message, sizeof(T));
+        slot.stamp.store(2 * seq, std::memory_order_release);
+    }
+
+    // False if 'seq' was never written, is still being written or has been overwritten
+    bool read(uint64_t seq, T& out) const {
+        const Slot& slot = slots[seq & MASK];
+        uint64_t before = slot.stamp.load(std::memory_order_acquire);
+        if (before != 2 * seq) return false;
+        std::memcpy(&out, &slot.message, sizeof(T));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return slot.stamp.load(std::memory_order_relaxed) == before;
+    }
+
+    static constexpr size_t capacity() { return Capacity; }
+
+private:
+    static constexpr size_t MASK = Capacity - 1;
+
+    struct Slot {
+        std::atomic<uint64_t> stamp;
+        T message;
+    };
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "Stamps live in raw mapped memory");
+    static constexpr size_t BYTES = Capacity * sizeof(Slot);
+
+    Slot* slots = nullptr;
+};
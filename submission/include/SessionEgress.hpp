@@ -0,0 +1,66 @@
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+#include "Constants.hpp"
+#include "Type.hpp"
+#include "MpscRing.hpp"
+#include "RetransmitStore.hpp"
+
+/**
+ * @brief Outbound execution reports of one session (order owner).
+ *
+ * Matching threads publish without blocking; the session's own thread polls. Every report
+ * gets the next sequence number of the session's stream and is kept in a retransmission
+ * window before it is pushed. A full ring drops the report and counts it, so a slow client
+ * can never stall matching; the consumer sees the sequence gap and asks for a gap fill.
+ *
+ * Books matched on different threads may publish to one session at once: the sequence is
+ * drawn and the report stored and pushed under one short spinlock, so the ring always holds
+ * reports in sequence order and a sequence is visible (getLastSequence) only once stored.
+ */
+class SessionEgress {
+public:
+    bool publish(ExecutionReport report) {
+        while (publishing.test_and_set(std::memory_order_acquire)) {
+            while (publishing.test(std::memory_order_relaxed)) {}
+        }
+        report.sequence = nextSequence.load(std::memory_order_relaxed) + 1;
+        history.write(report.sequence, report);
+        bool pushed = ring.tryPush(report);
+        nextSequence.store(report.sequence, std::memory_order_release);
+        publishing.clear(std::memory_order_release);
+
+        if (!pushed) dropped.fetch_add(1, std::memory_order_relaxed);
+        return pushed;
+    }
+
+    // Consumer (session) thread only
+    bool poll(ExecutionReport& out) { return ring.tryPop(out); }
+
+    /**
+     * Copies reports [from, to] into 'out' from the retransmission window. Safe from any
+     * thread. Stops at the first sequence that is not (or no longer) available and returns
+     * true only if the whole range was copied.
+     */
+    bool replay(uint64_t from, uint64_t to, std::vector<ExecutionReport>& out) const {
+        if (from == 0 || to < from || to > getLastSequence()) return false;
+        ExecutionReport report;
+        for (uint64_t seq = from; seq <= to; ++seq) {
+            if (!history.read(seq, report)) return false;
+            out.push_back(report);
+        }
+        return true;
+    }
+
+    uint64_t getLastSequence() const { return nextSequence.load(std::memory_order_acquire); }
+    uint64_t getDropped() const { return dropped.load(std::memory_order_relaxed); }
+
+private:
+    MpscRing<ExecutionReport, Config::EGRESS_RING_CAPACITY> ring;
+    RetransmitStore<ExecutionReport, Config::RETRANSMIT_CAPACITY> history;
+    std::atomic_flag publishing = ATOMIC_FLAG_INIT; // Serialises publishers (matcher lanes)
+    std::atomic<uint64_t> nextSequence{0};          // Last sequence stored and pushed
+    std::atomic<uint64_t> dropped{0};
+};
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <string>
+
+#include "Type.hpp"
+
+enum class SnapshotFormat : uint8_t { TEXT, BINARY };
+
+// Wire layout of a BINARY snapshot: this header, then bidCount + askCount BookLevels (bids first)
+struct SnapshotWireHeader {
+    static constexpr uint32_t MAGIC = 0x4B424B31; // "KBK1"
+    uint32_t magic;
+    uint16_t bidCount;
+    uint16_t askCount;
+    Symbol symbol;
+    SeqNum updateSeq;
+    uint64_t digest;
+    SeqNum epoch;
+    SeqNum marketDataSeq;
+};
+
+// The shell's BOOK display, byte for byte (ANSI-coloured ladder, asks on top)
+std::string renderSnapshotText(const OrderBookSnapshot& snap);
+std::string renderSnapshotBinary(const OrderBookSnapshot& snap);
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <string_view>
+#include <sys/mman.h>
+
+#include "Constants.hpp"
+
+/**
+ * @brief Blocked Bloom filter over every tag seen this session.
+ *
+ * Each tag maps to one 64-byte block (one cache line) and sets TAG_FILTER_HASHES bits in it,
+ * so a lookup costs a single cache miss. "False" means the tag was definitely never
+ * inserted; "true" means maybe, and the caller does the exact check. Never removes.
+ * The bit array is an anonymous mapping: untouched blocks cost no memory, and clear()
+ * hands the pages back instead of writing zeros.
+ */
+class TagFilter {
+public:
+    TagFilter() {
+        void* mem = ::mmap(nullptr, BYTES, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (mem == MAP_FAILED) throw std::bad_alloc();
+        blocks = static_cast<Block*>(mem);
+    }
+    ~TagFilter() { ::munmap(blocks, BYTES); }
+
+    TagFilter(const TagFilter&) = delete;
+    TagFilter& operator=(const TagFilter&) = delete;
+
+    void insert(std::string_view tag) {
+        uint64_t h = hash(tag);
+        Block& block = blocks[blockIndex(h)];
+        for (size_t i = 0; i < Config::TAG_FILTER_HASHES; ++i) {
+            uint32_t bit = bitIndex(h, i);
+            block.words[bit >> 6] |= uint64_t{1} << (bit & 63);
+        }
+    }
+
+    bool mayContain(std::string_view tag) const {
+        uint64_t h = hash(tag);
+        const Block& block = blocks[blockIndex(h)];
+        for (size_t i = 0; i < Config::TAG_FILTER_HASHES; ++i) {
+            uint32_t bit = bitIndex(h, i);
+            if (!(block.words[bit >> 6] & (uint64_t{1} << (bit & 63)))) return false;
+        }
+        return true;
+    }
+
+    void clear() { ::madvise(blocks, BYTES, MADV_DONTNEED); } // Private anonymous pages read back as zero
+
+private:
+    struct alignas(64) Block {
+        uint64_t words[8];
+    };
+    static constexpr size_t BYTES = Config::TAG_FILTER_BLOCKS * sizeof(Block);
+    static_assert((Config::TAG_FILTER_BLOCKS & (Config::TAG_FILTER_BLOCKS - 1)) == 0, "Block count must be a power of two");
+
+    Block* blocks = nullptr;
+
+    static uint64_t hash(std::string_view tag) {
+        uint64_t x = std::hash<std::string_view>{}(tag); // Finalised so both halves are well mixed
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+    static size_t blockIndex(uint64_t h) { return static_cast<size_t>(h) & (Config::TAG_FILTER_BLOCKS - 1); }
+    // Double hashing on the high half picks the bits inside the block
+    static uint32_t bitIndex(uint64_t h, size_t i) {
+        auto h1 = static_cast<uint32_t>(h >> 32);
+        uint32_t h2 = (h1 >> 9) | 1;
+        return (h1 + static_cast<uint32_t>(i) * h2) & 511;
+    }
+};
@@ -6,9 +6,17 @@
 #include <string>
 #include <atomic>
 #include <optional>
+#include <deque>
 
 #include "Type.hpp"
 #include "OrderBook.hpp"
+#include "OrderSlab.hpp"
+#include "Journal.hpp"
+#include "AuditLog.hpp"
+#include "SessionEgress.hpp"
+#include "OrderUpdates.hpp"
+#include "TagFilter.hpp"
+#include "BatchValidation.hpp"
 
 /**
  * @brief The TradingEngine: The Central Hub of the Matching System.
@@ -20,6 +28,18 @@ public:
     // --- Order Ingress (Public API) ---
     EngineResponse submitOrder(const LimitOrderRequest& req);
     EngineResponse submitOrder(const MarketOrderRequest& req);
+    EngineResponse submitOrder(const IcebergOrderRequest& req);
+    EngineResponse submitOrder(const PeggedOrderRequest& req);
+
+    // Batched ingress: validates the whole batch at once (see validateBatch), then registers
+    // and matches the survivors in batch order. One response per request, in order. Band and
+    // fragmentation limits are those of each book when the batch starts.
+    std::vector<EngineResponse> submitBatch(const std::vector<LimitOrderRequest>& batch);
+
+    // Opening / snapshot seed: rests every order on an empty book in one bulk load instead of
+    // one insert each. All orders must be for 'symbol' and must not cross; input order is time
+    // priority. All-or-nothing. Each seeded order is audited and acknowledged as if submitted.
+    EngineResponse seedBook(const Symbol& symbol, const std::vector<LimitOrderRequest>& orders);
 
     // --- Query & Control (Public API) ---
     // Updated: Uses OrderID (uint64_t)
@@ -28,44 +48,172 @@ public:
     
     // Updated: Uses Symbol struct
     EngineResponse getOrderBookSnapshot(const Symbol& symbol, size_t depth);
+    EngineResponse getGroupedOrderBookSnapshot(const Symbol& symbol, double bucketSize, size_t depth);
+    // Same book as getOrderBookSnapshot, already rendered; cached per book version
+    EngineResponse getRenderedSnapshot(const Symbol& symbol, size_t depth, SnapshotFormat format);
+
+    // Consistent cut: every requested book (all books if empty) as of one global epoch,
+    // taken without pausing matching
+    EngineResponse getMarketSnapshot(const std::vector<Symbol>& symbols, size_t depth);
+    // Current rolling digest of one book (response 'digest'), for cross-checking replicas
+    EngineResponse getBookDigest(const Symbol& symbol);
     
     // Updated: Uses OrderID (uint64_t)
     EngineResponse cancelOrder(OrderID id);
+    // Cancels only if the order rests in 'symbol''s book: for callers that own that one book
+    EngineResponse cancelOrder(OrderID id, const Symbol& symbol);
     EngineResponse cancelOrderByTag(const std::string& tag);
 
+    // --- Session Control ---
+    // End-of-day rollover: forgets every order and empties every book, but keeps the books
+    // and all container capacity allocated. Must not overlap with any other call.
+    void reset();
+
+    // --- Idle-Time Maintenance (bounded slices, see IdleScheduler) ---
+    // Moves up to 'maxOrders' terminal orders from the live registry into the compact archive.
+    // Archived orders stay queryable. Returns the number moved.
+    size_t archiveTerminalOrders(size_t maxOrders);
+    // Pulls every book's top-of-book into cache. Must run on the matcher thread.
+    void warmBooks();
+
+    // --- Persistent Order Store ---
+    // Attaches an mmap-backed slab file; every later state change is written through to it.
+    // If the file already holds orders (restart), books and registry are rebuilt from it first.
+    // Only valid on an empty engine without a journal.
+    EngineResponse attachStore(const std::string& path, size_t capacity = Config::STORE_CAPACITY);
+    void flushStore();
+    SeqNum getStoreSequence() const; // Requests persisted so far; 0 without a store
+
+    // --- Order Journal ---
+    // Appends every accepted order and cancel to a compact journal file. If the file already
+    // holds records (restart), they are replayed first, reproducing books, ids and fills.
+    // Replay runs one thread per symbol partition ('recoveryThreads', 0 = one per core) and
+    // leaves the same state as serial replay. Only valid on an empty engine without a store.
+    EngineResponse attachJournal(const std::string& path, size_t recoveryThreads = 0);
+    // Group commit of everything journalled since the last one (full blocks are synced in the
+    // background as they fill). A failed write or sync is reported until a retry succeeds.
+    EngineResponse commitJournal();
+    bool isPersistent() const { return store || journal; } // A store or journal is attached
+
+    // --- Audit Trail ---
+    // Accepted orders, fills, cancels and expiries are pushed to 'log' (not owned; null = off).
+    // Set before trading starts.
+    void setAuditLog(AuditLog* log) { audit = log; }
+
+    // --- Session Egress ---
+    // Every fill produces an ExecutionReport for the taker's and the maker's session, pushed
+    // into that session's ring. Returns the (engine-owned) ring, idempotent per session;
+    // nullptr for session 0 (anonymous).
+    SessionEgress* openSession(SessionID session);
+    // The session's consumer must have stopped polling before this is called
+    void closeSession(SessionID session);
+    // Shared ownership so off-path readers (gap fills) stay valid across closeSession
+    std::shared_ptr<const SessionEgress> findSession(SessionID session) const;
+
+    // --- Order Update Subscriptions ---
+    // Pushes ACK / PARTIAL_FILL / FILL / CANCEL transitions of the orders matching 'filter'.
+    // Callbacks run synchronously on the matching thread and must be short; they must not
+    // call back into subscribe/unsubscribe. Queues are owned by the caller and must outlive
+    // the subscription.
+    SubscriptionID subscribe(const SubscriptionFilter& filter, OrderUpdateCallback callback);
+    SubscriptionID subscribe(const SubscriptionFilter& filter, OrderUpdateQueue& queue);
+    void unsubscribe(SubscriptionID id);
+
+    // --- Market Data ---
+    // Every book (existing and future) emits L2 level changes and trades into its own
+    // broadcast ring; any number of readers follow it with a MarketDataCursor.
+    // Call before trading starts.
+    void enableMarketData();
+    std::vector<const MarketDataRing*> getMarketDataRings() const;
+
 private:
     // --- Internal Logic Pipeline ---
     
     // Updated: Uses Symbol and OrderID types
+    // checkCapacity = false: the caller has already reserved registry and store room
     EngineResponse validateCommon(const Symbol& symbol, double quantity, 
-                                 std::optional<double> price, const std::string& tag);
+                                 std::optional<double> price, const std::string& tag,
+                                 bool checkCapacity = true);
 
     EngineResponse processOrder(std::shared_ptr<Order> order);
 
-    EngineResponse finalizeExecution(const MatchResult& result, std::shared_ptr<Order> taker);
+    EngineResponse finalizeExecution(MatchResult result, std::shared_ptr<Order> taker);
 
-    EngineResponse internalCancel(OrderID orderId);
+    EngineResponse internalCancel(OrderID orderId, const Symbol* expectedSymbol = nullptr);
+
+    // Records orders that became terminal during a match so idle time can archive them
+    void queueTerminal(const MatchResult& result, const Order& taker);
+
+    // Write-through of one order's current state into its slab record (allocated on first write)
+    void persist(Order& order, const OrderBook& book);
+    void persistExecution(const MatchResult& result, Order& taker, const OrderBook& book);
+    // Rebuilds registry and books from journal records, partitioned by symbol across threads
+    void recoverFromJournal(std::vector<JournalRecord> records, size_t threads);
+
+    void auditExecution(const MatchResult& result, const Order& taker);
+
+    // Fans the fills of one match out to the owning sessions' egress rings
+    void routeExecutions(const MatchResult& result, const Order& taker);
+
+    struct Subscription {
+        SubscriptionID id;
+        OrderUpdateCallback callback; // Exactly one of callback / queue is set
+        OrderUpdateQueue* queue;
+    };
+    SubscriptionID addSubscription(const SubscriptionFilter& filter, Subscription sub);
+    void notify(const OrderUpdate& update);
+    void publishUpdates(const MatchResult& result, const Order& taker);
 
     // --- Venue Management ---
     
     // Updated: Uses Symbol struct
     OrderBook* getOrAddBook(const Symbol& sym);
     OrderBook* tryGetBook(const Symbol& sym) const;
+    // Live tags first, then archived ones. Caller holds registryMutex.
+    std::optional<OrderID> findTag(const std::string& tag) const;
 
     // --- Data Members ---
 
     // The Registry: Global map of all active and finished orders.
     // Updated: Keyed by OrderID (uint64_t)
     std::unordered_map<OrderID, std::shared_ptr<Order>> idRegistry;
-    std::unordered_map<std::string, OrderID> tagToId;
+    std::unordered_map<std::string, OrderID> tagToId;    // Tags of orders still in idRegistry
+    std::unordered_map<std::string, OrderID> archivedTags; // Cold: tags of archived orders
+    TagFilter tagFilter;                                  // Every tag of the session; checked first
+    std::unordered_map<OrderID, ArchivedOrder> archive; // Terminal orders moved out of idRegistry
+    std::deque<OrderID> terminalOrders;                  // Archival candidates, oldest first
     mutable std::shared_mutex registryMutex; 
 
     // The Bookshelf: Manages the collection of OrderBooks.
     // Updated: Keyed by Symbol struct (leveraging your custom std::hash<Symbol>)
     std::unordered_map<Symbol, std::unique_ptr<OrderBook>> symbolBooks;
     mutable std::shared_mutex bookshelfMutex; 
+    bool marketDataEnabled = false; // Guarded by bookshelfMutex
 
     // Global counters for the system
     // Updated: Uses ExecID (uint64_t)
     std::atomic<ExecID> nextExecId{1000000}; 
+
+    // Optional persistent image of every live order; null when running purely in memory
+    std::unique_ptr<OrderSlab> store;
+    // Optional write-ahead journal of accepted requests
+    std::unique_ptr<JournalWriter> journal;
+
+    AuditLog* audit = nullptr;
+
+    // Egress rings by session; openSessions lets the hot path skip the lock when nobody listens
+    std::unordered_map<SessionID, std::shared_ptr<SessionEgress>> sessions;
+    mutable std::shared_mutex sessionMutex;
+    std::atomic<size_t> openSessions{0};
+
+    // Subscribers indexed by scope, so a transition only visits the lists that can match it
+    std::vector<Subscription> allSubscribers;
+    std::unordered_map<SessionID, std::vector<Subscription>> sessionSubscribers;
+    std::unordered_map<Symbol, std::vector<Subscription>> symbolSubscribers;
+    mutable std::shared_mutex subscriptionMutex;
+    std::atomic<size_t> subscriberCount{0};
+    SubscriptionID nextSubscriptionId = 1;
+
+    // Bumped by every shadow publish of every book; defines the order of the consistent cut
+    std::atomic<SeqNum> globalEpoch{0};
 };
\ No newline at end of file
@@ -11,6 +11,7 @@
 #include <cstdint>
 #include <compare>
 #include <cstring>
+#include <array>
 
 #include "Constants.hpp"
 
@@ -18,6 +19,7 @@
 using OrderID = uint64_t;
 using ExecID  = uint64_t;
 using SeqNum  = uint64_t;
+using SessionID = uint32_t; // Owner of an order; 0 = anonymous (no execution reports)
 
 // --- The Symbol Struct ---
 // --- The "Zero-Copy" Symbol Struct ---
@@ -52,7 +54,8 @@ namespace std {
 
 // --- Enums & Basic Constants ---
 enum class Side { BUY, SELL };
-enum class OrderType { LIMIT, MARKET };
+enum class OrderType { LIMIT, MARKET, PEGGED };
+enum class PegType { NONE, PRIMARY, MID }; // PRIMARY: same-side best price | MID: BBO midpoint
 enum class OrderStatus { ACTIVE, FILLED, CANCELLED };
 
 enum class EngineStatusCode {
@@ -63,15 +66,20 @@ enum class EngineStatusCode {
     TAG_NOT_FOUND         = 104,
     DUPLICATE_TAG         = 105,
     PRICE_OUT_OF_BAND     = 106,
-    ALREADY_TERMINAL      = 107
+    ALREADY_TERMINAL      = 107,
+    SNAPSHOT_UNAVAILABLE  = 108,
+    STORE_FAILURE         = 109,
+    JOURNAL_FAILURE       = 110
 };
 
 // --- 1. OrderBook Internals ---
 struct Order; 
 
 struct OrderEntry {
-    double remainingQuantity;
+    double remainingQuantity;           // Displayed slice (the whole order unless iceberg)
     std::shared_ptr<Order> fatOrder; 
+    double hiddenQuantity = 0.0;        // Iceberg reserve; not part of PriceLevel::totalVolume
+    SeqNum priority = 0;                // Time priority stamp; refreshed when an iceberg slice reloads
 };
 
 struct PriceLevel {
@@ -84,6 +92,17 @@ struct OrderLocation {
     std::list<OrderEntry>::iterator it; // Iterator into the list is still stable
     double price;                       // Store the price to find the level later
     Side side;
+    PegType peg = PegType::NONE;        // != NONE: 'it' points into the pegged queue, not a level
+};
+
+// Pegged orders never sit on the ladder: their price is derived from the BBO at match time,
+// so a BBO move costs nothing. One FIFO lane per peg type keeps lookup of the best peg O(1).
+struct PeggedQueue {
+    std::list<OrderEntry> primary;
+    std::list<OrderEntry> mid;
+
+    std::list<OrderEntry>& lane(PegType peg) { return (peg == PegType::MID) ? mid : primary; }
+    bool empty() const { return primary.empty() && mid.empty(); }
 };
 
 // --- 2. The Order (The "Fat" Source of Truth) ---
@@ -103,10 +122,15 @@ struct Order {
     Side side;
     OrderType type;
     OrderStatus status = OrderStatus::ACTIVE;
+    PegType pegType = PegType::NONE; // Only meaningful for OrderType::PEGGED
+    double displayQuantity = 0.0;    // Iceberg peak size; 0.0 = fully displayed
     
     Symbol symbol;   
     std::string tag;   
 
+    uint32_t storeSlot = UINT32_MAX; // Record index in the attached OrderSlab; UINT32_MAX = not persisted
+    SessionID session = 0;           // Receives this order's execution reports
+
     mutable std::shared_mutex stateMutex; 
 
     Order(double p, double oQ, double rQ, double cC, Side s, 
@@ -115,6 +139,13 @@ struct Order {
           cumulativeCost(cC), side(s), type(t), status(st), 
           symbol(std::move(sym)), tag(std::move(tg)) {}
 
+    // Rehydration: restores an order under its original identity without touching globalCounter
+    Order(OrderID id, uint64_t ts, double p, double oQ, double rQ, double cC, Side s, 
+          OrderType t, OrderStatus st, Symbol sym, std::string tg)
+        : orderID(id), timestamp(ts), price(p), originalQuantity(oQ), remainingQuantity(rQ), 
+          cumulativeCost(cC), side(s), type(t), status(st), 
+          symbol(std::move(sym)), tag(std::move(tg)) {}
+
     Order(const Order&) = delete;
     Order& operator=(const Order&) = delete;
 
@@ -127,6 +158,19 @@ struct Order {
     }
 };
 
+// Book-side state of a resting order (what the fat Order does not know)
+struct RestingState {
+    double displayed;
+    double hidden;
+    SeqNum priority;
+};
+
+// One order to be put back on a book, e.g. when restoring from a persisted store
+struct RestingEntry {
+    std::shared_ptr<Order> order;
+    RestingState state;
+};
+
 // --- 3. Snapshot & Messaging Types ---
 
 struct BookLevel {
@@ -134,17 +178,40 @@ struct BookLevel {
     double quantity;
 };
 
+// Order-independent rolling hash of every resting entry, paired with the book version it describes.
+// Two books holding the same orders produce the same digest regardless of insertion history.
+struct BookDigest {
+    SeqNum sequence = 0;
+    uint64_t digest = 0;
+};
+
 struct OrderBookSnapshot {
     Symbol symbol;
     std::vector<BookLevel> bids;
     std::vector<BookLevel> asks;
     SeqNum updateSeq = 0; // ADDED: For versioning
+    uint64_t digest = 0;  // Rolling book digest at updateSeq
+    SeqNum epoch = 0;     // Global epoch at which this version was published
+    SeqNum marketDataSeq = 0; // Last market-data event reflected here; resume the feed after it
 };
 
 struct ShadowBuffer {
     std::vector<BookLevel> bids;
     std::vector<BookLevel> asks;
     SeqNum sequence = 0;   // ADDED: For versioning
+    uint64_t digest = 0;
+    SeqNum epoch = 0;      // Engine-wide publish counter; 0 = state before the first publish
+    SeqNum marketDataSeq = 0;
+
+    // One ladder per Config::DEPTH_BUCKET_SIZES entry, best bucket first
+    std::array<std::vector<BookLevel>, Config::DEPTH_BUCKET_SIZES.size()> groupedBids;
+    std::array<std::vector<BookLevel>, Config::DEPTH_BUCKET_SIZES.size()> groupedAsks;
+};
+
+// A cut across many books: every book as of the same global epoch
+struct MarketSnapshot {
+    SeqNum epoch = 0;
+    std::vector<OrderBookSnapshot> books;
 };
 
 struct FillRecord {
@@ -153,12 +220,45 @@ struct FillRecord {
     double quantity;
     OrderID takerOrderId;  // UPDATED
     OrderID makerOrderId;  // UPDATED
+    double makerRemaining = 0.0; // Maker's total leaves after this fill; 0.0 = maker done
+    SessionID makerSession = 0;  // Routes the maker's report without a registry lookup
+};
+
+// One side of one fill, pushed to the owning session's egress ring
+struct ExecutionReport {
+    SessionID session;
+    OrderID orderId;
+    OrderID counterpartyId;
+    ExecID executionId;
+    Symbol symbol;
+    Side side;
+    bool isMaker;          // Liquidity flag: true = resting side
+    double price;
+    double quantity;
+    double leavesQuantity; // Total still open after this fill; 0.0 = order done
+    uint64_t sequence = 0; // Per-session stream sequence, assigned on publish (first = 1)
+};
+
+// Terminal order moved out of the live registry: plain values, no mutex, no shared ownership
+struct ArchivedOrder {
+    uint64_t timestamp;
+    double price;
+    double originalQuantity;
+    double remainingQuantity = 0.0;
+    double cumulativeCost;
+    Side side;
+    OrderType type;
+    OrderStatus status;
+    PegType pegType;
+    Symbol symbol;
+    std::string tag;
 };
 
 struct MatchResult {
     OrderID takerOrderId;  // UPDATED
-    double remainingQuantity;
-    std::vector<FillRecord> fills;
+    double remainingQuantity = 0.0;
+    std::vector<FillRecord> fills{};
+    BookDigest book{};     // Book state right after this match was published
 };
 
 // --- 4. Engine Communication ---
@@ -168,6 +268,10 @@ struct EngineResponse {
     std::string message;
     std::shared_ptr<Order> order = nullptr;
     std::optional<OrderBookSnapshot> snapshot = std::nullopt;
+    std::optional<MarketSnapshot> market = std::nullopt;
+    std::optional<BookDigest> digest = std::nullopt; // Set on every book-mutating response
+    std::vector<FillRecord> fills{};                  // Executions caused by this request, in match order
+    std::shared_ptr<const std::string> rendered{};    // Pre-rendered snapshot bytes, shared with the book's cache
 
     static EngineResponse Success(std::string msg, std::shared_ptr<Order> o = nullptr) {
         return { EngineStatusCode::OK, std::move(msg), std::move(o) };
@@ -179,5 +283,7 @@ struct EngineResponse {
     bool isSuccess() const { return code == EngineStatusCode::OK; }
 };
 
-struct LimitOrderRequest { double price; double quantity; Side side; Symbol symbol; std::string tag; };
-struct MarketOrderRequest { double quantity; Side side; Symbol symbol; std::string tag; };
\ No newline at end of file
+struct LimitOrderRequest { double price; double quantity; Side side; Symbol symbol; std::string tag; SessionID session = 0; };
+struct MarketOrderRequest { double quantity; Side side; Symbol symbol; std::string tag; SessionID session = 0; };
+struct IcebergOrderRequest { double price; double quantity; double displayQuantity; Side side; Symbol symbol; std::string tag; SessionID session = 0; };
+struct PeggedOrderRequest { PegType peg; double quantity; Side side; Symbol symbol; std::string tag; SessionID session = 0; };
\ No newline at end of file
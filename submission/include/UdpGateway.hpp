@@ -0,0 +1,68 @@
+#pragma once
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <netinet/in.h>
+
+#include "Constants.hpp"
+#include "LatencyHistogram.hpp"
+#include "Type.hpp"
+
+class TradingEngine;
+
+// Hops of one request, each measured from the previous one on CLOCK_REALTIME (the kernel's
+// receive timestamp clock); TICK_TO_TRADE spans kernel receive to reply handed to the socket
+enum class GatewayStage : uint8_t { SOCKET_QUEUE, DECODE, DISPATCH, REPLY, TICK_TO_TRADE, COUNT };
+
+/**
+ * @brief UDP order entry: one shell command per datagram, one reply datagram back. Only
+ * order entry and queries are served (isGatewayCommand); session commands stay local.
+ *
+ * Every datagram carries its kernel receive timestamp (SO_TIMESTAMPNS) through decoding and
+ * matching; the reply's send completes the tick-to-trade measurement. Each stage feeds its
+ * own LatencyHistogram, so socket-queue and listener delays show up separately from matching.
+ * Not a thread: the matcher drains it, so gateway orders never race shell orders.
+ *
+ * There is no authentication, so the socket binds to loopback only. Each peer address gets
+ * its own session (up to GATEWAY_MAX_PEERS), which owns the orders it enters; CANCEL reaches
+ * only those.
+ */
+class UdpGateway {
+public:
+    explicit UdpGateway(TradingEngine& engine);
+    ~UdpGateway();
+
+    UdpGateway(const UdpGateway&) = delete;
+    UdpGateway& operator=(const UdpGateway&) = delete;
+
+    // "127.x.y.z:port" (port 0 = any free port); returns an error message, empty on success
+    std::string bind(std::string_view endpoint);
+
+    int getFd() const { return socketFd; }
+    uint16_t getPort() const;
+
+    // Serves up to GATEWAY_BATCH queued datagrams without blocking. Matcher thread only.
+    size_t drain();
+
+    const LatencyHistogram& getHistogram(GatewayStage stage) const { return histograms[static_cast<size_t>(stage)]; }
+    uint64_t getUntimestamped() const { return untimestamped; } // Fell back to user-space receive time
+    uint64_t getTruncated() const { return truncated; }         // Oversized, refused without dispatch
+    static const char* stageName(GatewayStage stage);
+
+private:
+    TradingEngine& engine;
+    int socketFd = -1;
+    std::array<LatencyHistogram, static_cast<size_t>(GatewayStage::COUNT)> histograms;
+    uint64_t untimestamped = 0;
+    uint64_t truncated = 0;
+    std::unordered_map<uint64_t, SessionID> peerSessions; // Keyed by address and port
+
+    // The peer's session, assigned on first contact; 0 once GATEWAY_MAX_PEERS are known
+    SessionID sessionFor(const sockaddr_in& peer);
+
+    void record(GatewayStage stage, uint64_t fromNs, uint64_t toNs) {
+        histograms[static_cast<size_t>(stage)].record(toNs > fromNs ? toNs - fromNs : 0);
+    }
+};
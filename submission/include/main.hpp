@@ -2,7 +2,6 @@
 
 #include <iostream>
 #include <string_view>
-#include <charconv>
 #include <queue>
 #include <mutex>
 #include <optional>
@@ -10,7 +9,14 @@
 #include <iomanip>
 #include <format>
 #include <condition_variable>
+#include <array>
+#include <poll.h>
+#include <unistd.h>
 #include "TradingEngine.hpp"
+#include "IdleScheduler.hpp"
+#include "CommandShell.hpp"
+#include "MarketDataPublisher.hpp"
+#include "UdpGateway.hpp"
 
 // --- Thread-Safe Blocking Queue ---
 template<typename T>
@@ -63,43 +69,72 @@ public:
     }
 };
 
-// --- High-Performance Zero-Copy Utilities ---
+// --- Pollable Line Reader ---
 
 /**
- * Advanced string_view window to extract tokens without allocation.
+ * Buffered line reader over stdin that can answer "is input pending?" without blocking,
+ * which std::cin cannot do reliably. Lets the shell hand quiet periods to the IdleScheduler.
  */
-inline std::string_view get_next_token(std::string_view& input) {
-    auto start = input.find_first_not_of(" \t\r\n");
-    if (start == std::string_view::npos) return "";
-    input.remove_prefix(start);
-    
-    auto end = input.find_first_of(" \t\r\n");
-    std::string_view token = input.substr(0, end);
-    input.remove_prefix(end == std::string_view::npos ? input.size() : end);
-    return token;
-}
+class StdinReader {
+private:
+    std::array<char, 64 * 1024> buffer;
+    size_t begin = 0;
+    size_t end = 0;
+    bool eof = false;
 
-/**
- * Fast integer conversion using <charconv>.
- */
-template<typename T>
-inline T to_num(std::string_view sv) {
-    T val{};
-    if (sv.empty()) return val;
-    std::from_chars(sv.data(), sv.data() + sv.size(), val);
-    return val;
-}
+    bool hasBufferedLine() const {
+        return std::string_view(buffer.data() + begin, end - begin).find('\n') != std::string_view::npos;
+    }
 
-/**
- * Fast double conversion using <charconv>.
- */
-inline double to_double(std::string_view sv) {
-    double val = 0.0;
-    if (sv.empty()) return val;
-    // Note: ensure your compiler fully supports floating point from_chars (C++20)
-    std::from_chars(sv.data(), sv.data() + sv.size(), val);
-    return val;
-}
+    // Blocks until more bytes arrive. Returns false at EOF/error.
+    bool fill() {
+        if (begin > 0) { // Compact so the free space is contiguous
+            std::copy(buffer.begin() + begin, buffer.begin() + end, buffer.begin());
+            end -= begin;
+            begin = 0;
+        }
+        if (end == buffer.size()) return true; // Line longer than buffer: hand out what we have
+        ssize_t n = ::read(STDIN_FILENO, buffer.data() + end, buffer.size() - end);
+        if (n <= 0) { eof = true; return false; }
+        end += static_cast<size_t>(n);
+        return true;
+    }
+
+public:
+    /**
+     * Non-blocking: true if a full line is buffered, stdin is readable, or input has ended.
+     */
+    bool pending() const {
+        if (eof || hasBufferedLine()) return true;
+        pollfd pfd{STDIN_FILENO, POLLIN, 0};
+        return ::poll(&pfd, 1, 0) > 0;
+    }
+
+    /**
+     * Sleeps until stdin (or 'alsoFd', if given) becomes readable or the timeout expires.
+     */
+    void waitReadable(int timeoutMs, int alsoFd = -1) const {
+        pollfd pfds[2] = {{STDIN_FILENO, POLLIN, 0}, {alsoFd, POLLIN, 0}};
+        ::poll(pfds, (alsoFd >= 0) ? 2 : 1, timeoutMs);
+    }
+
+    /**
+     * Blocking getline. Returns false once input is exhausted.
+     */
+    bool getline(std::string& line) {
+        while (!hasBufferedLine() && end - begin < buffer.size()) {
+            if (!fill()) break;
+        }
+        if (begin == end) return false;
+
+        std::string_view rest(buffer.data() + begin, end - begin);
+        size_t nl = rest.find('\n');
+        size_t len = (nl == std::string_view::npos) ? rest.size() : nl;
+        line.assign(rest.data(), len);
+        begin += (nl == std::string_view::npos) ? len : len + 1;
+        return true;
+    }
+};
 
 // --- UI/Display Prototypes ---
 
@@ -0,0 +1,84 @@
+#include "AuditLog.hpp"
+
+#include <chrono>
+#include <cstdio>
+
+namespace {
+    const char* kindName(AuditKind kind) {
+        switch (kind) {
+            case AuditKind::ACCEPT: return "ACCEPT";
+            case AuditKind::FILL:   return "FILL";
+            case AuditKind::CANCEL: return "CANCEL";
+            case AuditKind::EXPIRE: return "EXPIRE";
+        }
+        return "UNKNOWN";
+    }
+
+    void format(const AuditEvent& e, std::string& buffer) {
+        char line[256];
+        int len = std::snprintf(line, sizeof(line),
+            "%llu %s %s %s order=%llu cp=%llu exec=%llu px=%.8f qty=%.8f\n",
+            static_cast<unsigned long long>(e.timestampNs), kindName(e.kind), e.symbol.c_str(),
+            e.side == Side::BUY ? "BUY" : "SELL",
+            static_cast<unsigned long long>(e.orderId), static_cast<unsigned long long>(e.counterparty),
+            static_cast<unsigned long long>(e.execId), e.price, e.quantity);
+        buffer.append(line, static_cast<size_t>(std::min<int>(len, sizeof(line) - 1)));
+    }
+}
+
+AuditLog::AuditLog(const std::string& path) : out(path, std::ios::app) {}
+
+AuditLog::~AuditLog() {
+    stop();
+}
+
+uint64_t AuditLog::now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+void AuditLog::start() {
+    if (running.exchange(true)) return;
+    logger = std::thread(&AuditLog::run, this);
+}
+
+void AuditLog::stop() {
+    running.store(false, std::memory_order_release);
+    if (logger.joinable()) logger.join();
+}
+
+size_t AuditLog::drainBatch(std::string& buffer) {
+    buffer.clear();
+    AuditEvent event;
+    size_t count = 0;
+    while (count < Config::AUDIT_BATCH && ring.tryPop(event)) {
+        format(event, buffer);
+        ++count;
+    }
+
+    uint64_t drops = dropped.load(std::memory_order_relaxed);
+    if (drops != reportedDrops) {
+        buffer += std::to_string(now()) + " DROPPED " + std::to_string(drops - reportedDrops) + "\n";
+        reportedDrops = drops;
+    }
+
+    if (!buffer.empty()) {
+        out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        out.flush();
+        written.fetch_add(count, std::memory_order_relaxed);
+    }
+    return count;
+}
+
+void AuditLog::run() {
+    std::string buffer;
+    buffer.reserve(Config::AUDIT_BATCH * 128);
+
+    while (running.load(std::memory_order_acquire)) {
+        if (drainBatch(buffer) == 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(Config::AUDIT_IDLE_US));
+        }
+    }
+    // Final drain: everything pushed before stop() reaches the file
+    while (drainBatch(buffer) > 0) {}
+}
@@ -0,0 +1,58 @@
+#include "BatchValidation.hpp"
+
+#include <algorithm>
+#include <bit>
+
+void ValidationBatch::resize(size_t n) {
+    quantity.resize(n);
+    price.resize(n);
+    bandLow.resize(n);
+    bandHigh.resize(n);
+    tagLength.resize(n);
+    symbolEmpty.resize(n);
+    fragmented.resize(n);
+    reason.resize(n);
+    rejectMask.resize((n + 63) / 64);
+}
+
+size_t validateBatch(ValidationBatch& batch) {
+    const size_t n = batch.size();
+    const double* __restrict qty = batch.quantity.data();
+    const double* __restrict px = batch.price.data();
+    const double* __restrict lo = batch.bandLow.data();
+    const double* __restrict hi = batch.bandHigh.data();
+    const uint32_t* __restrict tagLen = batch.tagLength.data();
+    const uint8_t* __restrict noSymbol = batch.symbolEmpty.data();
+    const uint8_t* __restrict full = batch.fragmented.data();
+    auto* __restrict out = reinterpret_cast<uint8_t*>(batch.reason.data());
+
+    // Later checks are applied first so the earliest failing one wins, as in validateCommon.
+    // Flags are 0/1 integers combined with '|' and masks, never '||' or ifs, so the loop has
+    // no branches and vectorizes.
+    auto pick = [](uint32_t current, uint32_t failed, BatchReject code) {
+        uint32_t mask = 0u - failed; // All ones if the check failed
+        return (current & ~mask) | (static_cast<uint32_t>(code) & mask);
+    };
+    for (size_t i = 0; i < n; ++i) {
+        uint32_t r = 0;
+        r = pick(r, static_cast<uint32_t>(px[i] > hi[i]) | static_cast<uint32_t>(px[i] < lo[i]), BatchReject::PRICE_BAND);
+        r = pick(r, full[i], BatchReject::FRAGMENTED);
+        r = pick(r, static_cast<uint32_t>(px[i] < Config::MIN_ORDER_PRICE) |
+                    static_cast<uint32_t>(px[i] > Config::MAX_ORDER_PRICE), BatchReject::PRICE_RANGE);
+        r = pick(r, noSymbol[i], BatchReject::SYMBOL);
+        r = pick(r, static_cast<uint32_t>(tagLen[i] > static_cast<uint32_t>(Config::MAX_TAG_SIZE)), BatchReject::TAG);
+        r = pick(r, static_cast<uint32_t>(qty[i] <= 0.0) |
+                    static_cast<uint32_t>(qty[i] > static_cast<double>(Config::MAX_ORDER_QTY)), BatchReject::QUANTITY);
+        out[i] = static_cast<uint8_t>(r);
+    }
+
+    size_t rejected = 0;
+    for (size_t word = 0; word < batch.rejectMask.size(); ++word) {
+        uint64_t bits = 0;
+        size_t base = word * 64, count = std::min<size_t>(64, n - base);
+        for (size_t j = 0; j < count; ++j) bits |= static_cast<uint64_t>(out[base + j] != 0) << j;
+        batch.rejectMask[word] = bits;
+        rejected += static_cast<size_t>(std::popcount(bits));
+    }
+    return rejected;
+}
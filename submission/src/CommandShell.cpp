@@ -0,0 +1,111 @@
+#include "CommandShell.hpp"
+
+std::optional<EngineResponse> dispatchCommand(TradingEngine& engine, std::string_view cmd, std::string_view sv,
+                                              SessionID session) {
+    if (cmd == "ECHO") {
+        EngineResponse resp;
+        resp.code = EngineStatusCode::OK;
+        resp.message = std::string(sv);
+        return resp;
+    }
+    else if (cmd == "LIMIT") {
+        std::string_view s_side = get_next_token(sv);
+        std::string_view sym_name = get_next_token(sv);
+        double qty = to_double(get_next_token(sv));
+        double price = to_double(get_next_token(sv));
+        std::string_view tag = get_next_token(sv);
+
+        Side side = (s_side == "BUY") ? Side::BUY : Side::SELL;
+        return engine.submitOrder(LimitOrderRequest{
+            price, qty, side, Symbol{sym_name}, std::string(tag), session
+        });
+    }
+    else if (cmd == "MARKET") {
+        std::string_view s_side = get_next_token(sv);
+        std::string_view sym_name = get_next_token(sv);
+        double qty = to_double(get_next_token(sv));
+        std::string_view tag = get_next_token(sv);
+
+        Side side = (s_side == "BUY") ? Side::BUY : Side::SELL;
+        return engine.submitOrder(MarketOrderRequest{
+            qty, side, Symbol{sym_name}, std::string(tag), session
+        });
+    }
+    else if (cmd == "ICEBERG") {
+        std::string_view s_side = get_next_token(sv);
+        std::string_view sym_name = get_next_token(sv);
+        double qty = to_double(get_next_token(sv));
+        double displayQty = to_double(get_next_token(sv));
+        double price = to_double(get_next_token(sv));
+        std::string_view tag = get_next_token(sv);
+
+        Side side = (s_side == "BUY") ? Side::BUY : Side::SELL;
+        return engine.submitOrder(IcebergOrderRequest{
+            price, qty, displayQty, side, Symbol{sym_name}, std::string(tag), session
+        });
+    }
+    else if (cmd == "PEG") {
+        std::string_view s_side = get_next_token(sv);
+        std::string_view sym_name = get_next_token(sv);
+        double qty = to_double(get_next_token(sv));
+        std::string_view s_peg = get_next_token(sv);
+        std::string_view tag = get_next_token(sv);
+
+        Side side = (s_side == "BUY") ? Side::BUY : Side::SELL;
+        PegType peg = (s_peg == "MID") ? PegType::MID : (s_peg == "PRIMARY") ? PegType::PRIMARY : PegType::NONE;
+        return engine.submitOrder(PeggedOrderRequest{
+            peg, qty, side, Symbol{sym_name}, std::string(tag), session
+        });
+    }
+    else if (cmd == "CANCEL") {
+        OrderID id = to_num<OrderID>(get_next_token(sv));
+        if (session != 0) {
+            // A session cancels only its own orders; anyone else's look the same as missing ones
+            EngineResponse owner = engine.getOrder(id);
+            if (!owner.isSuccess() || !owner.order || owner.order->session != session) {
+                return EngineResponse::Error(EngineStatusCode::ORDER_ID_NOT_FOUND, "ID missing");
+            }
+        }
+        return engine.cancelOrder(id);
+    }
+    else if (cmd == "RESET") {
+        engine.reset();
+        return EngineResponse::Success("Session reset");
+    }
+    else if (cmd == "DEPTH") {
+        std::string_view sym_name = get_next_token(sv);
+        double bucketSize = to_double(get_next_token(sv));
+        int depth = to_num<int>(get_next_token(sv));
+        if (depth == 0) depth = 5;
+        return engine.getGroupedOrderBookSnapshot(Symbol{sym_name}, bucketSize, depth);
+    }
+    else if (cmd == "BOOKS") {
+        int depth = to_num<int>(get_next_token(sv));
+        if (depth == 0) depth = 5;
+        std::vector<Symbol> symbols;
+        for (auto sym_name = get_next_token(sv); !sym_name.empty(); sym_name = get_next_token(sv)) {
+            symbols.emplace_back(sym_name);
+        }
+        return engine.getMarketSnapshot(symbols, depth);
+    }
+    else if (cmd == "BOOK") {
+        std::string_view sym_name = get_next_token(sv);
+        int depth = to_num<int>(get_next_token(sv));
+        if (depth == 0) depth = 5;
+        return engine.getRenderedSnapshot(Symbol{sym_name}, depth, SnapshotFormat::TEXT);
+    }
+    else if (cmd == "DIGEST") {
+        return engine.getBookDigest(Symbol{get_next_token(sv)});
+    }
+    return std::nullopt;
+}
+
+bool isGatewayCommand(std::string_view cmd) {
+    static constexpr std::string_view allowed[] = {
+        "ECHO", "LIMIT", "MARKET", "ICEBERG", "PEG", "CANCEL", "DEPTH", "BOOKS", "BOOK", "DIGEST"
+    };
+    for (std::string_view name : allowed) {
+        if (cmd == name) return true;
+    }
+    return false;
+}
@@ -0,0 +1,43 @@
+#include "GapFillServer.hpp"
+#include "TradingEngine.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+GapFillServer::GapFillServer(const TradingEngine& engine) : engine(engine) {}
+
+GapFillServer::~GapFillServer() {
+    stop();
+}
+
+void GapFillServer::start() {
+    if (running.exchange(true)) return;
+    server = std::thread(&GapFillServer::run, this);
+}
+
+void GapFillServer::stop() {
+    running.store(false, std::memory_order_release);
+    if (server.joinable()) server.join();
+}
+
+bool GapFillServer::serveOne() {
+    GapFillRequest req;
+    if (!queue.tryPop(req)) return false;
+
+    GapFillReply reply{req.session, req.fromSequence, req.toSequence, {}, false};
+    if (auto egress = engine.findSession(req.session); egress && req.fromSequence <= req.toSequence) {
+        uint64_t last = std::min(req.toSequence, req.fromSequence + Config::GAPFILL_MAX_MESSAGES - 1);
+        reply.reports.reserve(static_cast<size_t>(last - req.fromSequence + 1));
+        reply.complete = egress->replay(req.fromSequence, last, reply.reports) && last == req.toSequence;
+    }
+    if (req.reply) req.reply(std::move(reply));
+    served.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void GapFillServer::run() {
+    while (running.load(std::memory_order_acquire)) {
+        if (!serveOne()) std::this_thread::sleep_for(std::chrono::microseconds(Config::GAPFILL_IDLE_US));
+    }
+    while (serveOne()) {}
+}
@@ -0,0 +1,37 @@
+#include "IdleScheduler.hpp"
+
+void IdleScheduler::addTask(std::string name, Task step) {
+    tasks.push_back(Entry{std::move(name), std::move(step)});
+}
+
+size_t IdleScheduler::runIdle(std::chrono::nanoseconds budget, const std::function<bool()>& shouldYield) {
+    if (tasks.empty()) return 0;
+
+    const auto deadline = std::chrono::steady_clock::now() + budget;
+    for (auto& task : tasks) task.drained = false;
+
+    size_t slices = 0;
+    size_t drainedCount = 0;
+    while (drainedCount < tasks.size()) {
+        Entry& task = tasks[cursor];
+        cursor = (cursor + 1) % tasks.size();
+        if (task.drained) continue;
+
+        // Preemption point: checked before every slice, never inside one
+        if (shouldYield() || std::chrono::steady_clock::now() >= deadline) break;
+
+        ++slices;
+        if (!task.step()) {
+            task.drained = true;
+            ++drainedCount;
+        }
+    }
+    return slices;
+}
+
+bool IdleScheduler::hasPendingWork() const {
+    for (const auto& task : tasks) {
+        if (!task.drained) return true;
+    }
+    return false;
+}
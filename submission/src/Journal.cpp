@@ -0,0 +1,436 @@
+#include "Journal.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+    // Low two bits of the opcode byte; ORDER packs its enums into the upper six
+    constexpr uint8_t OP_ORDER = 1;
+    constexpr uint8_t OP_CANCEL = 2;
+    constexpr uint8_t OP_SYMBOL = 3; // Interns the next symbol id for the rest of the block
+    constexpr uint8_t FLAG_ICEBERG = 0x80;
+
+    uint32_t fnv1a(const char* data, size_t len) {
+        uint32_t h = 2166136261u;
+        for (size_t i = 0; i < len; ++i) h = (h ^ static_cast<uint8_t>(data[i])) * 16777619u;
+        return h;
+    }
+
+    double fromTicks(int64_t ticks) { return static_cast<double>(ticks) / Config::JOURNAL_TICKS_PER_UNIT; }
+
+    // True when value sits exactly on the tick grid (and within exact double range), so ticks round-trip
+    bool toTicks(double value, int64_t& ticks) {
+        double scaled = value * Config::JOURNAL_TICKS_PER_UNIT;
+        if (!(std::fabs(scaled) < 0x1p53)) return false;
+        ticks = std::llround(scaled);
+        return fromTicks(ticks) == value;
+    }
+
+    uint64_t zigzag(int64_t v) { return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63); }
+    int64_t unzigzag(uint64_t v) { return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1); }
+
+    void putVarint(std::string& out, uint64_t v) {
+        while (v >= 0x80) {
+            out.push_back(static_cast<char>(v | 0x80));
+            v >>= 7;
+        }
+        out.push_back(static_cast<char>(v));
+    }
+
+    void putBytes(std::string& out, std::string_view bytes) {
+        putVarint(out, bytes.size());
+        out.append(bytes);
+    }
+
+    // Low bit of the leading varint: 0 = tick value in the upper bits, 1 = raw double follows
+    void putRaw(std::string& out, double value) {
+        putVarint(out, 1);
+        out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    void putQuantity(std::string& out, double value) {
+        int64_t ticks;
+        if (toTicks(value, ticks) && ticks >= 0) putVarint(out, static_cast<uint64_t>(ticks) << 1);
+        else putRaw(out, value);
+    }
+
+    // Bounds-checked decoding over one block payload; any overrun marks the block bad
+    struct Decoder {
+        const std::string& in;
+        size_t& pos;
+        bool ok = true;
+
+        uint64_t varint() {
+            uint64_t v = 0;
+            for (int shift = 0; shift < 64; shift += 7) {
+                if (pos >= in.size()) break;
+                auto byte = static_cast<uint8_t>(in[pos++]);
+                v |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                if (!(byte & 0x80)) return v;
+            }
+            ok = false;
+            return 0;
+        }
+        int64_t svarint() { return unzigzag(varint()); }
+        uint8_t byte() {
+            if (pos >= in.size()) { ok = false; return 0; }
+            return static_cast<uint8_t>(in[pos++]);
+        }
+        std::string_view bytes(uint64_t len) {
+            if (len > in.size() - pos) { ok = false; return {}; }
+            std::string_view v(in.data() + pos, len);
+            pos += len;
+            return v;
+        }
+        double raw() {
+            double v = 0.0;
+            std::string_view b = bytes(sizeof(v));
+            if (ok) std::memcpy(&v, b.data(), sizeof(v));
+            return v;
+        }
+        double quantity() {
+            uint64_t v = varint();
+            return (v & 1) ? raw() : fromTicks(static_cast<int64_t>(v >> 1));
+        }
+    };
+
+    bool writeAll(int fd, const char* data, size_t len) {
+        while (len > 0) {
+            ssize_t n = ::write(fd, data, len);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                return false;
+            }
+            data += n;
+            len -= static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    bool readAt(int fd, void* dst, size_t len, uint64_t offset) {
+        auto* p = static_cast<char*>(dst);
+        while (len > 0) {
+            ssize_t n = ::pread(fd, p, len, static_cast<off_t>(offset));
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) return false;
+            p += n;
+            len -= static_cast<size_t>(n);
+            offset += static_cast<uint64_t>(n);
+        }
+        return true;
+    }
+}
+
+// ============================================================================
+// WRITER
+// ============================================================================
+
+JournalWriter::~JournalWriter() {
+    if (fd < 0) return;
+    commit();
+    {
+        std::lock_guard lock(syncMutex);
+        stopping = true;
+    }
+    syncWake.notify_one();
+    syncer.join();
+    ::close(fd);
+}
+
+std::string JournalWriter::open(const std::string& path) {
+    // Find the intact prefix first: a crash mid-write leaves a torn block that replay ignores
+    uint64_t intact = 0, records = 0;
+    {
+        JournalReader reader;
+        if (reader.open(path).empty()) {
+            JournalRecord record;
+            while (reader.next(record)) {}
+            intact = reader.getIntactBytes();
+            records = reader.getRecordIndex();
+        }
+    }
+
+    fd = ::open(path.c_str(), O_WRONLY | O_CREAT, 0644);
+    if (fd < 0) return "Cannot open journal " + path + ": " + std::strerror(errno);
+    if (::ftruncate(fd, static_cast<off_t>(intact)) != 0 || ::lseek(fd, static_cast<off_t>(intact), SEEK_SET) < 0) {
+        std::string err = "Cannot truncate journal " + path + ": " + std::strerror(errno);
+        ::close(fd);
+        fd = -1;
+        return err;
+    }
+    nextRecord = records;
+    bytesWritten = intact;
+    payload.reserve(Config::JOURNAL_BLOCK_BYTES + 256);
+    resetBlockState();
+    syncer = std::thread(&JournalWriter::syncLoop, this);
+    return {};
+}
+
+void JournalWriter::resetBlockState() {
+    payload.clear();
+    blockRecords = 0;
+    symbols.clear();
+    lastOrderId = 0;
+    lastTimestamp = 0;
+    lastTag.clear();
+}
+
+void JournalWriter::endRecord() {
+    ++blockRecords;
+    ++nextRecord;
+    if (payload.size() >= Config::JOURNAL_BLOCK_BYTES) seal();
+}
+
+void JournalWriter::appendOrder(const Order& order) {
+    if (fd < 0) return;
+
+    auto [it, fresh] = symbols.try_emplace(order.symbol, static_cast<uint32_t>(symbols.size()), 0);
+    if (fresh) {
+        payload.push_back(static_cast<char>(OP_SYMBOL));
+        putBytes(payload, order.symbol.c_str());
+    }
+    auto& [symbolId, lastPrice] = it->second;
+
+    bool iceberg = order.displayQuantity > 0.0;
+    payload.push_back(static_cast<char>(OP_ORDER |
+        (static_cast<uint8_t>(order.side) << 2) |
+        (static_cast<uint8_t>(order.type) << 3) |
+        (static_cast<uint8_t>(order.pegType) << 5) |
+        (iceberg ? FLAG_ICEBERG : 0)));
+    putVarint(payload, zigzag(static_cast<int64_t>(order.orderID - lastOrderId)));
+    putVarint(payload, zigzag(static_cast<int64_t>(order.timestamp - lastTimestamp)));
+    putVarint(payload, symbolId);
+    if (order.type == OrderType::LIMIT) {
+        // An off-grid price leaves the delta base alone
+        int64_t ticks;
+        if (toTicks(order.price, ticks)) {
+            putVarint(payload, zigzag(ticks - lastPrice) << 1);
+            lastPrice = ticks;
+        } else {
+            putRaw(payload, order.price);
+        }
+    }
+    putQuantity(payload, order.originalQuantity);
+    if (iceberg) putQuantity(payload, order.displayQuantity);
+    putVarint(payload, order.session);
+
+    // Tags are unique per order, so a whole-tag dictionary never hits; clients number them
+    // sequentially, so the previous tag's prefix almost always does
+    size_t shared = 0;
+    size_t limit = std::min(order.tag.size(), lastTag.size());
+    while (shared < limit && order.tag[shared] == lastTag[shared]) ++shared;
+    putVarint(payload, shared);
+    putBytes(payload, std::string_view(order.tag).substr(shared));
+    lastTag = order.tag;
+
+    lastOrderId = order.orderID;
+    lastTimestamp = order.timestamp;
+    endRecord();
+}
+
+void JournalWriter::appendCancel(OrderID id) {
+    if (fd < 0) return;
+    payload.push_back(static_cast<char>(OP_CANCEL));
+    putVarint(payload, zigzag(static_cast<int64_t>(id - lastOrderId)));
+    lastOrderId = id;
+    endRecord();
+}
+
+void JournalWriter::seal() {
+    JournalBlockHeader header{JournalBlockHeader::MAGIC, static_cast<uint32_t>(payload.size()), blockRecords,
+                              fnv1a(payload.data(), payload.size()), nextRecord - blockRecords};
+    {
+        std::lock_guard lock(syncMutex);
+        sealed.append(reinterpret_cast<const char*>(&header), sizeof(header));
+        sealed += payload;
+    }
+    syncWake.notify_one();
+    resetBlockState();
+}
+
+void JournalWriter::syncLoop() {
+    std::unique_lock lock(syncMutex);
+    while (true) {
+        syncWake.wait(lock, [this] { return stopping || (!sealed.empty() && !stalled); });
+        if (sealed.empty() || stalled) return; // Stopping, and nothing more will be written
+
+        // Everything sealed so far goes out in one write and one sync
+        std::string batch;
+        batch.swap(sealed);
+        syncing = true;
+        const uint64_t intact = bytesWritten;
+        lock.unlock();
+
+        const char* failed = !writeAll(fd, batch.data(), batch.size()) ? "write"
+                           : (::fdatasync(fd) != 0)                     ? "fdatasync"
+                           : nullptr;
+        std::string err;
+        if (failed) {
+            // A partial frame mid-file would hide every later block from replay: cut it off
+            err = std::string("Journal ") + failed + " failed: " + std::strerror(errno);
+            if (::ftruncate(fd, static_cast<off_t>(intact)) != 0 ||
+                ::lseek(fd, static_cast<off_t>(intact), SEEK_SET) < 0) {
+                err += " (and the torn block could not be cut off)";
+            }
+        }
+
+        lock.lock();
+        syncing = false;
+        if (failed) {
+            // Kept ahead of anything sealed meanwhile
+            sealed.insert(0, batch);
+            error = std::move(err);
+            stalled = true;
+        } else {
+            bytesWritten += batch.size();
+            error.clear();
+        }
+        syncDone.notify_all();
+    }
+}
+
+std::string JournalWriter::commit() {
+    if (fd < 0) return {};
+    if (blockRecords > 0) seal();
+
+    std::unique_lock lock(syncMutex);
+    stalled = false;
+    syncWake.notify_one();
+    syncDone.wait(lock, [this] { return stalled || (sealed.empty() && !syncing); });
+    return error;
+}
+
+void JournalWriter::clear() {
+    resetBlockState();
+    if (fd < 0) return;
+    std::unique_lock lock(syncMutex);
+    syncDone.wait(lock, [this] { return !syncing; });
+    sealed.clear();
+    stalled = false;
+    error.clear();
+    if (::ftruncate(fd, 0) == 0 && ::lseek(fd, 0, SEEK_SET) == 0) ::fdatasync(fd);
+    nextRecord = 0;
+    bytesWritten = 0;
+}
+
+// ============================================================================
+// READER
+// ============================================================================
+
+JournalReader::~JournalReader() {
+    if (fd >= 0) ::close(fd);
+}
+
+std::string JournalReader::open(const std::string& path) {
+    fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return "Cannot open journal " + path + ": " + std::strerror(errno);
+    return {};
+}
+
+bool JournalReader::loadBlock(bool decode) {
+    JournalBlockHeader header;
+    if (fd < 0 || !readAt(fd, &header, sizeof(header), fileOffset)) return false;
+    if (header.magic != JournalBlockHeader::MAGIC || header.recordCount == 0) return false;
+    if (!decode) {
+        // Header hop only (seek); the payload is verified when it is actually decoded
+        recordIndex = header.firstRecord + header.recordCount;
+        fileOffset += sizeof(header) + header.payloadBytes;
+        return true;
+    }
+
+    payload.resize(header.payloadBytes);
+    if (!readAt(fd, payload.data(), payload.size(), fileOffset + sizeof(header))) return false;
+    if (fnv1a(payload.data(), payload.size()) != header.checksum) return false;
+
+    fileOffset += sizeof(header) + header.payloadBytes;
+    intactBytes = fileOffset;
+    recordIndex = header.firstRecord;
+    recordsLeft = header.recordCount;
+    cursor = 0;
+    symbols.clear();
+    lastOrderId = 0;
+    lastTimestamp = 0;
+    lastTag.clear();
+    return true;
+}
+
+bool JournalReader::next(JournalRecord& out) {
+    if (recordsLeft == 0 && !loadBlock(true)) return false;
+
+    Decoder in{payload, cursor};
+    uint8_t op = in.byte();
+    while (in.ok && (op & 0x3) == OP_SYMBOL) {
+        symbols.emplace_back(Symbol(in.bytes(in.varint())), 0);
+        op = in.byte();
+    }
+
+    out = JournalRecord{};
+    if ((op & 0x3) == OP_CANCEL) {
+        out.type = JournalRecordType::CANCEL;
+        out.orderId = lastOrderId + static_cast<OrderID>(in.svarint());
+    } else if ((op & 0x3) == OP_ORDER) {
+        out.type = JournalRecordType::ORDER;
+        out.side = static_cast<Side>((op >> 2) & 0x1);
+        out.orderType = static_cast<OrderType>((op >> 3) & 0x3);
+        out.pegType = static_cast<PegType>((op >> 5) & 0x3);
+        out.orderId = lastOrderId + static_cast<OrderID>(in.svarint());
+        out.timestamp = lastTimestamp + static_cast<uint64_t>(in.svarint());
+
+        uint64_t symbolId = in.varint();
+        if (symbolId >= symbols.size()) return false;
+        auto& [symbol, lastPrice] = symbols[symbolId];
+        out.symbol = symbol;
+        if (out.orderType == OrderType::LIMIT) {
+            uint64_t v = in.varint();
+            if (v & 1) {
+                out.price = in.raw();
+            } else {
+                lastPrice += unzigzag(v >> 1);
+                out.price = fromTicks(lastPrice);
+            }
+        }
+        out.quantity = in.quantity();
+        if (op & FLAG_ICEBERG) out.displayQuantity = in.quantity();
+        out.session = in.varint();
+
+        uint64_t shared = in.varint();
+        if (shared > lastTag.size()) return false;
+        lastTag.resize(shared);
+        lastTag += in.bytes(in.varint());
+        out.tag = lastTag;
+        lastTimestamp = out.timestamp;
+    } else {
+        return false;
+    }
+    if (!in.ok) return false;
+
+    lastOrderId = out.orderId;
+    --recordsLeft;
+    ++recordIndex;
+    return true;
+}
+
+bool JournalReader::seek(uint64_t index) {
+    fileOffset = 0;
+    recordIndex = 0;
+    recordsLeft = 0;
+    // Hop whole blocks without decoding them, then decode forward inside the target block
+    for (;;) {
+        uint64_t blockStart = fileOffset;
+        if (!loadBlock(false)) return false;
+        if (index < recordIndex) {
+            fileOffset = blockStart;
+            break;
+        }
+    }
+    if (!loadBlock(true)) return false;
+    JournalRecord skipped;
+    while (recordIndex < index) {
+        if (!next(skipped)) return false;
+    }
+    return true;
+}
@@ -0,0 +1,139 @@
+#include "MarketDataPublisher.hpp"
+#include "TradingEngine.hpp"
+#include "Endpoint.hpp"
+
+#include <algorithm>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+
+MarketDataPublisher::MarketDataPublisher(const TradingEngine& engine)
+    : engine(engine), batch(Config::MD_DATAGRAMS_PER_SEND) {
+    socketFd = ::socket(AF_INET, SOCK_DGRAM, 0);
+}
+
+MarketDataPublisher::~MarketDataPublisher() {
+    stop();
+    if (socketFd >= 0) ::close(socketFd);
+}
+
+std::string MarketDataPublisher::addEndpoint(std::string_view endpoint) {
+    if (socketFd < 0) return "Cannot open UDP socket";
+
+    sockaddr_in addr;
+    if (std::string error = parseEndpoint(endpoint, addr); !error.empty()) return error;
+
+    if (IN_MULTICAST(ntohl(addr.sin_addr.s_addr))) {
+        // Stay on the host's network segment and deliver to local listeners too
+        unsigned char ttl = 1, loop = 1;
+        ::setsockopt(socketFd, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl));
+        ::setsockopt(socketFd, IPPROTO_IP, IP_MULTICAST_LOOP, &loop, sizeof(loop));
+    }
+    endpoints.push_back(addr);
+    return {};
+}
+
+void MarketDataPublisher::start() {
+    if (running.exchange(true)) return;
+    iovs.resize(batch.size() * endpoints.size());
+    msgs.resize(batch.size() * endpoints.size());
+    publisher = std::thread(&MarketDataPublisher::run, this);
+}
+
+void MarketDataPublisher::stop() {
+    running.store(false, std::memory_order_release);
+    if (publisher.joinable()) publisher.join();
+}
+
+void MarketDataPublisher::seal() {
+    Datagram& open = batch[sealed];
+    if (open.header.count == 0) return;
+    open.header.magic = MarketDataPacketHeader::MAGIC;
+    open.header.eventSize = sizeof(MarketDataEvent);
+    open.header.packetSequence = ++nextPacketSequence;
+    if (++sealed == batch.size()) sendBatch();
+}
+
+void MarketDataPublisher::sendBatch() {
+    if (sealed == 0) return;
+    if (!endpoints.empty()) {
+        // Every sealed datagram to every endpoint, one message each
+        size_t total = sealed * endpoints.size();
+        for (size_t d = 0, m = 0; d < sealed; ++d) {
+            for (auto& endpoint : endpoints) {
+                iovs[m] = {&batch[d], batch[d].size()};
+                msgs[m] = {};
+                msgs[m].msg_hdr.msg_name = &endpoint;
+                msgs[m].msg_hdr.msg_namelen = sizeof(endpoint);
+                msgs[m].msg_hdr.msg_iov = &iovs[m];
+                msgs[m].msg_hdr.msg_iovlen = 1;
+                ++m;
+            }
+        }
+
+        size_t done = 0;
+        while (done < total) {
+            int sent = ::sendmmsg(socketFd, msgs.data() + done, static_cast<unsigned>(total - done), 0);
+            if (sent < 0) {
+                if (errno == EINTR) continue;
+                // UDP semantics: the rest of this batch is lost, and downstream sees the packet gap
+                sendErrors.fetch_add(total - done, std::memory_order_relaxed);
+                break;
+            }
+            done += static_cast<size_t>(sent);
+        }
+        datagramsSent.fetch_add(done, std::memory_order_relaxed);
+    }
+
+    for (size_t d = 0; d < sealed; ++d) {
+        eventsSent.fetch_add(batch[d].header.count, std::memory_order_relaxed);
+        batch[d].header.count = 0;
+    }
+    sealed = 0;
+}
+
+size_t MarketDataPublisher::pump() {
+    constexpr size_t perRingLimit = Config::MD_EVENTS_PER_DATAGRAM * Config::MD_DATAGRAMS_PER_SEND;
+    size_t taken = 0;
+    for (MarketDataCursor& cursor : cursors) {
+        // Bounded per ring so one busy book cannot starve the others
+        for (size_t n = 0; n < perRingLimit; ++n) {
+            Datagram& open = batch[sealed];
+            CursorStatus status = cursor.poll(open.events[open.header.count]);
+            if (status == CursorStatus::LAPPED) {
+                laps.fetch_add(1, std::memory_order_relaxed);
+                cursor.resync();
+                continue;
+            }
+            if (status == CursorStatus::EMPTY) break;
+            ++taken;
+            if (++open.header.count == Config::MD_EVENTS_PER_DATAGRAM) seal();
+        }
+    }
+    seal();
+    sendBatch();
+    return taken;
+}
+
+void MarketDataPublisher::discoverBooks() {
+    // Books are never removed, so cursors are only ever added
+    for (const MarketDataRing* ring : engine.getMarketDataRings()) {
+        bool known = std::ranges::any_of(cursors, [ring](const auto& c) { return c.getRing() == ring; });
+        if (!known) cursors.emplace_back(*ring); // From sequence 1; resynced on first poll if already lapped
+    }
+}
+
+void MarketDataPublisher::run() {
+    discoverBooks();
+    while (running.load(std::memory_order_acquire)) {
+        if (pump() == 0) {
+            // Quiet: pick up books created since the last pass, then back off
+            discoverBooks();
+            std::this_thread::sleep_for(std::chrono::microseconds(Config::MD_IDLE_US));
+        }
+    }
+    discoverBooks();
+    while (pump() > 0) {}
+}
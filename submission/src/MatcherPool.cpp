@@ -0,0 +1,180 @@
+#include "MatcherPool.hpp"
+#include "TradingEngine.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <type_traits>
+
+MatcherPool::MatcherPool(TradingEngine& engine, size_t threads) : engine(engine) {
+    for (size_t i = 0; i < std::max<size_t>(threads, 1); ++i) matchers.push_back(std::make_unique<Matcher>());
+}
+
+MatcherPool::~MatcherPool() {
+    stop();
+}
+
+bool MatcherPool::start() {
+    if (engine.isPersistent()) return false;
+    if (running.exchange(true)) return true;
+    for (size_t i = 0; i < matchers.size(); ++i) matchers[i]->thread = std::thread(&MatcherPool::runMatcher, this, i);
+    balancer = std::thread(&MatcherPool::runBalancer, this);
+    return true;
+}
+
+void MatcherPool::stop() {
+    running.store(false, std::memory_order_release);
+    if (balancer.joinable()) balancer.join();
+    for (auto& matcher : matchers) {
+        if (matcher->thread.joinable()) matcher->thread.join();
+    }
+    // Every matcher has exited, so this thread may pop any lane, including lanes in transit
+    std::shared_lock lock(laneMutex);
+    for (auto& [symbol, lane] : lanes) {
+        while (serveLane(*lane) > 0) {}
+    }
+}
+
+bool MatcherPool::submit(MatcherTask task) {
+    const Symbol& symbol = std::visit([](const auto& req) -> const Symbol& { return req.symbol; }, task.request);
+    return laneFor(symbol)->ring.tryPush(task);
+}
+
+MatcherPool::Lane* MatcherPool::laneFor(const Symbol& symbol) {
+    {
+        std::shared_lock lock(laneMutex);
+        if (auto it = lanes.find(symbol); it != lanes.end()) return it->second.get();
+    }
+    std::unique_lock lock(laneMutex);
+    auto& lane = lanes[symbol];
+    if (!lane) {
+        size_t home = nextHome++ % matchers.size();
+        lane = std::make_unique<Lane>(symbol, home);
+        while (!matchers[home]->inbox.tryPush(lane.get())) std::this_thread::yield();
+    }
+    return lane.get();
+}
+
+int MatcherPool::getOwner(const Symbol& symbol) const {
+    std::shared_lock lock(laneMutex);
+    auto it = lanes.find(symbol);
+    return (it != lanes.end()) ? static_cast<int>(it->second->target.load(std::memory_order_relaxed)) : -1;
+}
+
+uint64_t MatcherPool::getProcessed(const Symbol& symbol) const {
+    std::shared_lock lock(laneMutex);
+    auto it = lanes.find(symbol);
+    return (it != lanes.end()) ? it->second->processed.load(std::memory_order_relaxed) : 0;
+}
+
+// ============================================================================
+// MATCHER THREADS
+// ============================================================================
+
+size_t MatcherPool::serveLane(Lane& lane) {
+    MatcherTask task;
+    size_t served = 0;
+    while (served < Config::POOL_BATCH && lane.ring.tryPop(task)) {
+        EngineResponse resp = std::visit([this, &lane](const auto& req) {
+            if constexpr (std::is_same_v<std::decay_t<decltype(req)>, CancelRequest>) {
+                return engine.cancelOrder(req.orderId, lane.symbol);
+            } else {
+                return engine.submitOrder(req);
+            }
+        }, task.request);
+        if (task.reply) task.reply(std::move(resp));
+        ++served;
+    }
+    if (served > 0) lane.processed.fetch_add(served, std::memory_order_relaxed);
+    return served;
+}
+
+void MatcherPool::handOver(Lane* lane, size_t to) {
+    // Safe point: this thread is between batches and never touches the lane again.
+    // The inbox push publishes the ring's consumer state to the new owner.
+    while (!matchers[to]->inbox.tryPush(lane)) std::this_thread::yield();
+    migrations.fetch_add(1, std::memory_order_relaxed);
+}
+
+void MatcherPool::runMatcher(size_t index) {
+    Matcher& self = *matchers[index];
+    while (running.load(std::memory_order_acquire)) {
+        Lane* adopted;
+        while (self.inbox.tryPop(adopted)) {
+            adopted->owner.store(index, std::memory_order_relaxed);
+            self.lanes.push_back(adopted);
+        }
+
+        size_t served = 0;
+        for (size_t i = 0; i < self.lanes.size();) {
+            Lane* lane = self.lanes[i];
+            size_t to = lane->target.load(std::memory_order_acquire);
+            if (to != index) {
+                self.lanes[i] = self.lanes.back();
+                self.lanes.pop_back();
+                handOver(lane, to);
+                continue;
+            }
+            served += serveLane(*lane);
+            ++i;
+        }
+        if (served == 0) std::this_thread::sleep_for(std::chrono::microseconds(Config::POOL_IDLE_US));
+    }
+}
+
+// ============================================================================
+// BALANCING
+// ============================================================================
+
+bool MatcherPool::rebalance() {
+    std::lock_guard balance(balanceMutex);
+    std::shared_lock lock(laneMutex);
+
+    std::vector<uint64_t> load(matchers.size(), 0);
+    std::vector<std::pair<Lane*, uint64_t>> recent;
+    recent.reserve(lanes.size());
+    bool moving = false;
+    for (auto& [symbol, lane] : lanes) {
+        uint64_t now = lane->processed.load(std::memory_order_relaxed);
+        uint64_t delta = now - lane->sampled;
+        lane->sampled = now;
+        size_t target = lane->target.load(std::memory_order_relaxed);
+        moving |= (target != lane->owner.load(std::memory_order_relaxed));
+        load[target] += delta;
+        recent.emplace_back(lane.get(), delta);
+    }
+    if (moving) return false; // Let the last move settle before judging its effect
+
+    auto [coldIt, hotIt] = std::minmax_element(load.begin(), load.end());
+    size_t hot = static_cast<size_t>(hotIt - load.begin());
+    size_t cold = static_cast<size_t>(coldIt - load.begin());
+    uint64_t gap = *hotIt - *coldIt;
+    if (gap < Config::POOL_MIN_IMBALANCE) return false;
+
+    // Moving a lane with load d leaves max(hot - d, cold + d): any 0 < d < gap helps,
+    // d closest to gap / 2 helps most. A matcher with a single busy lane cannot be helped.
+    Lane* best = nullptr;
+    uint64_t bestDistance = UINT64_MAX;
+    for (auto [lane, delta] : recent) {
+        if (lane->target.load(std::memory_order_relaxed) != hot || delta == 0 || delta >= gap) continue;
+        uint64_t distance = (delta * 2 > gap) ? delta * 2 - gap : gap - delta * 2;
+        if (distance < bestDistance) {
+            best = lane;
+            bestDistance = distance;
+        }
+    }
+    if (!best) return false;
+    best->target.store(cold, std::memory_order_release);
+    return true;
+}
+
+void MatcherPool::runBalancer() {
+    auto next = std::chrono::steady_clock::now();
+    while (running.load(std::memory_order_acquire)) {
+        next += std::chrono::milliseconds(Config::POOL_REBALANCE_MS);
+        // Sleep in short steps so stop() is not held up by a whole period
+        while (running.load(std::memory_order_acquire) && std::chrono::steady_clock::now() < next) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        if (running.load(std::memory_order_acquire)) rebalance();
+    }
+}
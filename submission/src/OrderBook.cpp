@@ -1,35 +1,48 @@
 #include "OrderBook.hpp"
 
-OrderBook::OrderBook(Symbol sym) : symbol(std::move(sym)) {
+OrderBook::OrderBook(Symbol sym, std::atomic<SeqNum>& epochClock) 
+    : symbol(std::move(sym)), epochClock(epochClock) {
     // Reserve memory upfront to avoid mid-trade latency spikes
     bids.reserve(Config::MAX_PRICE_LEVELS / 2);
     asks.reserve(Config::MAX_PRICE_LEVELS / 2);
 }
 
-void OrderBook::placeOrder(std::shared_ptr<Order> order) {
-    auto& targetSide = (order->side == Side::BUY) ? bids : asks;
+std::vector<PriceLevel>::iterator OrderBook::levelFor(Side side, double price) {
+    auto& targetSide = (side == Side::BUY) ? bids : asks;
 
     // 1. Binary search for the insertion point
     // Note: We use raw comparison here for the search logic (std::lower_bound needs it)
-    auto it = std::lower_bound(targetSide.begin(), targetSide.end(), order->price,
+    auto it = std::lower_bound(targetSide.begin(), targetSide.end(), price,
         [&](const PriceLevel& lvl, double p) {
-            if (order->side == Side::BUY) return lvl.price > p; // Bids: High to Low
+            if (side == Side::BUY) return lvl.price > p; // Bids: High to Low
             return lvl.price < p; // Asks: Low to High
         });
 
     // 2. Check for existence using Precision::equal (The Epsilon Check)
     // We must check if 'it' is valid AND if the price matches our epsilon
-    bool levelExists = (it != targetSide.end() && Precision::equal(it->price, order->price));
+    bool levelExists = (it != targetSide.end() && Precision::equal(it->price, price));
 
     if (!levelExists) {
         // Create new level if epsilon check fails
-        it = targetSide.insert(it, PriceLevel{order->price});
+        it = targetSide.insert(it, PriceLevel{price});
     }
+    return it;
+}
+
+void OrderBook::placeOrder(std::shared_ptr<Order> order) {
+    auto it = levelFor(order->side, order->price);
 
     // 3. Update the Level Volume using Precision-safe addition logic if necessary
     // (Though simple addition is usually fine, we use totalVolume for snapshots)
-    it->totalVolume += order->remainingQuantity;
-    it->entries.push_back(OrderEntry{order->remainingQuantity, order});
+    // Icebergs only expose their peak; the rest waits in hiddenQuantity
+    OrderEntry entry{order->remainingQuantity, order, 0.0, nextPriority++};
+    if (Precision::isPositive(order->displayQuantity) && order->displayQuantity < order->remainingQuantity) {
+        entry.remainingQuantity = order->displayQuantity;
+        entry.hiddenQuantity = order->remainingQuantity - order->displayQuantity;
+    }
+    adjustLevelVolume(order->side, *it, entry.remainingQuantity);
+    it->entries.push_back(entry);
+    bookDigest += entryDigest(entry);
 
     // 4. Update the Global Index
     idToLocation[order->orderID] = { 
@@ -39,12 +52,128 @@ void OrderBook::placeOrder(std::shared_ptr<Order> order) {
     };
 }
 
+void OrderBook::placePegged(std::shared_ptr<Order> order) {
+    auto& lane = ((order->side == Side::BUY) ? peggedBids : peggedAsks).lane(order->pegType);
+    lane.push_back(OrderEntry{order->remainingQuantity, order, 0.0, nextPriority++});
+    bookDigest += entryDigest(lane.back());
+
+    // Price is left at 0.0: a peg has no stored price, only a reference
+    idToLocation[order->orderID] = { 
+        std::prev(lane.end()), 
+        0.0, 
+        order->side,
+        order->pegType
+    };
+}
+
+std::optional<double> OrderBook::effectivePegPrice(PegType peg, Side restingSide) const {
+    if (peg == PegType::PRIMARY) {
+        const auto& sameSide = (restingSide == Side::BUY) ? bids : asks;
+        if (sameSide.empty()) return std::nullopt;
+        return sameSide.front().price;
+    }
+    if (bids.empty() || asks.empty()) return std::nullopt;
+    return (bids.front().price + asks.front().price) / 2.0;
+}
+
+double OrderBook::fillEntry(OrderEntry& entry, double price, Order& taker,
+                            MatchResult& result, std::atomic<ExecID>& nextExecId) {
+    double matchQty = std::min(taker.remainingQuantity, entry.remainingQuantity);
+    bookDigest -= entryDigest(entry);
+    
+    auto& fill = result.fills.emplace_back(FillRecord{
+        nextExecId.fetch_add(1, std::memory_order_relaxed),
+        price, matchQty, taker.orderID, entry.fatOrder->orderID
+    });
+
+    {
+        std::unique_lock lock(entry.fatOrder->stateMutex);
+        // Use subtract_or_zero to prevent drift
+        Precision::subtract_or_zero(entry.remainingQuantity, matchQty);
+        Precision::subtract_or_zero(entry.fatOrder->remainingQuantity, matchQty);
+        entry.fatOrder->cumulativeCost += (matchQty * price);
+        
+        if (Precision::isZero(entry.remainingQuantity) && Precision::isZero(entry.hiddenQuantity)) {
+            entry.fatOrder->status = OrderStatus::FILLED;
+            entry.fatOrder->remainingQuantity = 0.0; // Hard zero
+        }
+        fill.makerRemaining = entry.fatOrder->remainingQuantity;
+    }
+    fill.makerSession = entry.fatOrder->session;
+    bookDigest += entryDigest(entry);
+
+    Precision::subtract_or_zero(taker.remainingQuantity, matchQty);
+    taker.cumulativeCost += (matchQty * price);
+    return matchQty;
+}
+
+void OrderBook::adjustLevelVolume(Side side, PriceLevel& level, double delta) {
+    auto applyDelta = [delta](double& volume) {
+        if (delta >= 0.0) volume += delta;
+        else Precision::subtract_or_zero(volume, -delta);
+    };
+    applyDelta(level.totalVolume);
+    if (marketData) marketData->publish(MarketDataKind::LEVEL, side, symbol, level.price, level.totalVolume);
+
+    auto& ladders = (side == Side::BUY) ? bidBuckets : askBuckets;
+    for (size_t g = 0; g < ladders.size(); ++g) {
+        BucketLadder& ladder = ladders[g];
+        int64_t idx = bucketIndex(level.price, Config::DEPTH_BUCKET_SIZES[g], side);
+        auto it = ladder.volumes.try_emplace(idx, 0.0).first;
+        applyDelta(it->second);
+        // Erased on Precision::isZero, so the rounding residue of many deltas never lingers
+        if (Precision::isZero(it->second)) ladder.volumes.erase(it);
+
+        // Past the last bucket of a full window, nothing published moves
+        if (!ladder.worstPublished ||
+            ((side == Side::BUY) ? idx >= *ladder.worstPublished : idx <= *ladder.worstPublished)) {
+            ladder.dirty = true;
+        }
+    }
+}
+
+void OrderBook::matchMidPegs(Order& taker, MatchResult& result, std::atomic<ExecID>& nextExecId) {
+    // Opposite mid pegs price at the same midpoint, so resting beside them would lock the book
+    std::optional<double> mid = effectivePegPrice(PegType::MID, taker.side);
+    if (!mid) return;
+
+    auto& lane = ((taker.side == Side::BUY) ? peggedAsks : peggedBids).mid;
+    while (Precision::isPositive(taker.remainingQuantity) && !lane.empty()) {
+        auto entryIt = lane.begin();
+        double matchQty = fillEntry(*entryIt, *mid, taker, result, nextExecId);
+        lastMatchedPrice.store(*mid, std::memory_order_relaxed);
+        if (marketData) marketData->publish(MarketDataKind::TRADE, taker.side, symbol, *mid, matchQty);
+
+        if (Precision::isZero(entryIt->remainingQuantity)) {
+            bookDigest -= entryDigest(*entryIt);
+            idToLocation.erase(entryIt->fatOrder->orderID);
+            lane.erase(entryIt);
+        }
+    }
+}
+
+void OrderBook::replenishIceberg(PriceLevel& level, std::list<OrderEntry>::iterator entryIt) {
+    double slice = std::min(entryIt->fatOrder->displayQuantity, entryIt->hiddenQuantity);
+    bookDigest -= entryDigest(*entryIt);
+    entryIt->remainingQuantity = slice;
+    Precision::subtract_or_zero(entryIt->hiddenQuantity, slice);
+    entryIt->priority = nextPriority++;
+    adjustLevelVolume(entryIt->fatOrder->side, level, slice);
+    bookDigest += entryDigest(*entryIt);
+
+    // splice relinks the node: no allocation, and idToLocation's iterator stays valid
+    level.entries.splice(level.entries.end(), level.entries, entryIt);
+}
+
 // Updated: Uses OrderID (uint64_t)
 std::optional<double> OrderBook::getRemainingQty(OrderID id) const {
     auto itLoc = idToLocation.find(id);
     if (itLoc == idToLocation.end()) return std::nullopt;
 
-    const auto& [entryIt, price, side] = itLoc->second;
+    const auto& [entryIt, price, side, peg] = itLoc->second;
+    // Pegged entries live in their lane until removed from the index
+    if (peg != PegType::NONE) return entryIt->remainingQuantity;
+
     const auto& targetSide = (side == Side::BUY) ? bids : asks;
 
     // Binary search for the price level
@@ -57,7 +186,7 @@ std::optional<double> OrderBook::getRemainingQty(OrderID id) const {
     if (itLevel != targetSide.end() && Precision::equal(itLevel->price, price)) {
         // Double check: Does the entry still exist in this level?
         // Since we store a list iterator, we can access it directly.
-        return entryIt->remainingQuantity;
+        return entryIt->remainingQuantity + entryIt->hiddenQuantity;
     }
 
     return std::nullopt;
@@ -70,7 +199,17 @@ std::optional<double> OrderBook::cancelById(OrderID id) {
 
     // We retrieve the price and side (stable values) 
     // and the list iterator (stable for std::list)
-    auto [entryIt, price, side] = itLoc->second;
+    auto [entryIt, price, side, peg] = itLoc->second;
+
+    if (peg != PegType::NONE) {
+        double removedQty = entryIt->remainingQuantity;
+        bookDigest -= entryDigest(*entryIt);
+        ((side == Side::BUY) ? peggedBids : peggedAsks).lane(peg).erase(entryIt);
+        idToLocation.erase(itLoc);
+        publishShadow();
+        return removedQty;
+    }
+
     auto& targetSide = (side == Side::BUY) ? bids : asks;
 
     // 2. Binary search to find the PriceLevel in the vector
@@ -82,9 +221,10 @@ std::optional<double> OrderBook::cancelById(OrderID id) {
 
     // 3. Verify the level matches our price using Precision
     if (itLevel != targetSide.end() && Precision::equal(itLevel->price, price)) {
-        double removedQty = entryIt->remainingQuantity;
+        double removedQty = entryIt->remainingQuantity + entryIt->hiddenQuantity;
         
-        Precision::subtract_or_zero(itLevel->totalVolume, removedQty);
+        adjustLevelVolume(side, *itLevel, -entryIt->remainingQuantity);
+        bookDigest -= entryDigest(*entryIt);
 
         // Remove from the list (This is safe because it's std::list)
         itLevel->entries.erase(entryIt);
@@ -98,6 +238,8 @@ std::optional<double> OrderBook::cancelById(OrderID id) {
             // Note: This shift is O(N), but for 20k levels, it's very fast.
         }
         
+        // Readers must never see a sequence whose digest or levels still hold the cancelled entry
+        publishShadow();
         return removedQty;
     }
 
@@ -107,12 +249,19 @@ std::optional<double> OrderBook::cancelById(OrderID id) {
 MatchResult OrderBook::execute(std::shared_ptr<Order> taker, std::atomic<ExecID>& nextExecId) {
     MatchResult result{.takerOrderId = taker->orderID};
 
-    if (taker->side == Side::BUY) matchAgainstBook(asks, taker, result, nextExecId);
-    else matchAgainstBook(bids, taker, result, nextExecId);
+    // Pegged orders join their lane and price lazily; only a mid peg can cross on arrival
+    if (taker->type != OrderType::PEGGED) {
+        if (taker->side == Side::BUY) matchAgainstBook(asks, peggedAsks, taker, result, nextExecId);
+        else matchAgainstBook(bids, peggedBids, taker, result, nextExecId);
+    } else if (taker->pegType == PegType::MID) {
+        matchMidPegs(*taker, result, nextExecId);
+    }
 
     // 1. If there is meaningful quantity left after matching
     if (Precision::isPositive(taker->remainingQuantity)) {
-        if (taker->type == OrderType::LIMIT) {
+        if (taker->type == OrderType::PEGGED) {
+            placePegged(taker);
+        } else if (taker->type == OrderType::LIMIT) {
             placeOrder(taker); // Post to book
         } else {
             // Market Order ran out of liquidity
@@ -131,14 +280,24 @@ MatchResult OrderBook::execute(std::shared_ptr<Order> taker, std::atomic<ExecID>
 
     publishShadow();
     result.remainingQuantity = taker->remainingQuantity;
+    result.book = getDigest();
     return result; 
 }
 
 void OrderBook::publishShadow() {
     // Unique lock: Only one thread (the Matcher) writes to the shadow
     std::unique_lock lock(shadowMutex);
+
+    // Recycle the oldest version; its vectors keep their capacity
+    const ShadowBuffer& previous = shadows[shadowHead];
+    SeqNum sequence = previous.sequence + 1;
+    shadowHead = (shadowHead + 1) % shadows.size();
+    ShadowBuffer& shadow = shadows[shadowHead];
     
-    shadow.sequence++;
+    shadow.sequence = sequence;
+    shadow.epoch = epochClock.fetch_add(1, std::memory_order_acq_rel) + 1;
+    shadow.digest = bookDigest;
+    shadow.marketDataSeq = marketData ? marketData->getLastSequence() : 0;
     shadow.bids.clear();
     shadow.asks.clear();
 
@@ -155,15 +314,114 @@ void OrderBook::publishShadow() {
     for (const auto& level : asks) {
         shadow.asks.push_back({level.price, level.totalVolume});
     }
+
+    // Grouped depth: a window no change reached carries over from the previous version;
+    // otherwise the best MAX_GROUPED_DEPTH buckets are read off the map, already in price order
+    auto publishGrouped = [](BucketLadder& ladder, auto best, auto end, double bucketSize,
+                             const std::vector<BookLevel>& carried, std::vector<BookLevel>& dest) {
+        if (!ladder.dirty) {
+            dest.assign(carried.begin(), carried.end());
+            return;
+        }
+        dest.clear();
+        ladder.worstPublished.reset();
+        for (; best != end && dest.size() < Config::MAX_GROUPED_DEPTH; ++best) {
+            dest.push_back({static_cast<double>(best->first) * bucketSize, best->second});
+            if (dest.size() == Config::MAX_GROUPED_DEPTH) ladder.worstPublished = best->first;
+        }
+        ladder.dirty = false;
+    };
+    for (size_t g = 0; g < Config::DEPTH_BUCKET_SIZES.size(); ++g) {
+        const double bucketSize = Config::DEPTH_BUCKET_SIZES[g];
+        BucketLadder& bidLadder = bidBuckets[g];
+        BucketLadder& askLadder = askBuckets[g];
+        publishGrouped(bidLadder, bidLadder.volumes.rbegin(), bidLadder.volumes.rend(), bucketSize,
+                       previous.groupedBids[g], shadow.groupedBids[g]);
+        publishGrouped(askLadder, askLadder.volumes.begin(), askLadder.volumes.end(), bucketSize,
+                       previous.groupedAsks[g], shadow.groupedAsks[g]);
+    }
 }
 
 OrderBookSnapshot OrderBook::getSnapshot(size_t depth) const {
     // Shared lock: Multiple API threads can snapshot while the Matcher is busy
     std::shared_lock lock(shadowMutex); 
-    
+    return snapshotFrom(shadows[shadowHead], depth);
+}
+
+std::optional<OrderBookSnapshot> OrderBook::getGroupedSnapshot(double bucketSize, size_t depth) const {
+    auto sizeIt = std::ranges::find_if(Config::DEPTH_BUCKET_SIZES, 
+        [&](double size) { return Precision::equal(size, bucketSize); });
+    if (sizeIt == Config::DEPTH_BUCKET_SIZES.end()) return std::nullopt;
+    size_t g = static_cast<size_t>(sizeIt - Config::DEPTH_BUCKET_SIZES.begin());
+
+    std::shared_lock lock(shadowMutex);
+    const ShadowBuffer& shadow = shadows[shadowHead];
+
+    OrderBookSnapshot snap;
+    snap.symbol = this->symbol;
+    snap.updateSeq = shadow.sequence;
+    snap.digest = shadow.digest;
+    snap.epoch = shadow.epoch;
+    snap.marketDataSeq = shadow.marketDataSeq;
+    snap.bids.assign(shadow.groupedBids[g].begin(), shadow.groupedBids[g].begin() + std::min(depth, shadow.groupedBids[g].size()));
+    snap.asks.assign(shadow.groupedAsks[g].begin(), shadow.groupedAsks[g].begin() + std::min(depth, shadow.groupedAsks[g].size()));
+    return snap;
+}
+
+std::optional<OrderBookSnapshot> OrderBook::getSnapshotAt(SeqNum epoch, size_t depth) const {
+    std::shared_lock lock(shadowMutex);
+
+    // Walk newest -> oldest. Never-written slots carry epoch 0 and stand for the empty
+    // pre-publish book, which is exactly right for a book younger than the cut.
+    for (size_t i = 0; i < shadows.size(); ++i) {
+        const ShadowBuffer& version = shadows[(shadowHead + shadows.size() - i) % shadows.size()];
+        if (version.epoch <= epoch) return snapshotFrom(version, depth);
+    }
+    return std::nullopt;
+}
+
+std::shared_ptr<const std::string> OrderBook::getRenderedSnapshot(size_t depth, SnapshotFormat format) const {
+    auto matches = [depth, format](const RenderedSnapshot& slot) {
+        return slot.bytes && slot.depth == depth && slot.format == format;
+    };
+
+    OrderBookSnapshot snap;
+    {
+        std::shared_lock lock(shadowMutex);
+        SeqNum current = shadows[shadowHead].sequence;
+        {
+            std::shared_lock cacheLock(renderMutex);
+            for (const auto& slot : renderCache) {
+                if (matches(slot) && slot.updateSeq == current) return slot.bytes;
+            }
+        }
+        snap = snapshotFrom(shadows[shadowHead], depth);
+    }
+
+    // Rendered outside both locks; readers of the old version keep their buffer alive
+    auto bytes = std::make_shared<const std::string>(
+        (format == SnapshotFormat::TEXT) ? renderSnapshotText(snap) : renderSnapshotBinary(snap));
+
+    std::unique_lock cacheLock(renderMutex);
+    RenderedSnapshot* victim = &renderCache[0];
+    for (auto& slot : renderCache) {
+        if (matches(slot)) { victim = &slot; break; }
+        if (!slot.bytes || (victim->bytes && slot.updateSeq < victim->updateSeq)) victim = &slot;
+    }
+    // A slower thread must not replace a newer rendering with its older one
+    if (!matches(*victim) || victim->updateSeq <= snap.updateSeq) {
+        *victim = {snap.updateSeq, depth, format, bytes};
+    }
+    return bytes;
+}
+
+OrderBookSnapshot OrderBook::snapshotFrom(const ShadowBuffer& shadow, size_t depth) const {
     OrderBookSnapshot snap;
     snap.symbol = this->symbol;
     snap.updateSeq = shadow.sequence;
+    snap.digest = shadow.digest;
+    snap.epoch = shadow.epoch;
+    snap.marketDataSeq = shadow.marketDataSeq;
 
     // Helper to extract top 'depth' levels from shadow vectors
     auto copyTopLevels = [&](const std::vector<BookLevel>& src, std::vector<BookLevel>& dest) {
@@ -178,4 +436,179 @@ OrderBookSnapshot OrderBook::getSnapshot(size_t depth) const {
     copyTopLevels(shadow.asks, snap.asks);
     
     return snap;
+}
+
+void OrderBook::warmTopOfBook() const {
+    uint64_t sink = 0;
+    auto touch = [&](const std::vector<PriceLevel>& side) {
+        size_t count = std::min(side.size(), Config::WARM_LEVELS);
+        for (size_t i = 0; i < count; ++i) {
+            sink += std::bit_cast<uint64_t>(side[i].totalVolume);
+            if (!side[i].entries.empty()) {
+                const OrderEntry& head = side[i].entries.front();
+                sink += head.priority + head.fatOrder->orderID;
+            }
+        }
+    };
+    touch(bids);
+    touch(asks);
+    // Empty asm that claims to read the sum: keeps the loads without a store to shared memory
+    asm volatile("" : : "r"(sink));
+}
+
+const MarketDataRing* OrderBook::enableMarketData() {
+    if (!marketData) marketData = std::make_unique<MarketDataRing>();
+    return marketData.get();
+}
+
+void OrderBook::reset() {
+    if (marketData) { // Subscribers must see the ladder empty out, not just stop updating
+        for (const auto& level : bids) marketData->publish(MarketDataKind::LEVEL, Side::BUY, symbol, level.price, 0.0);
+        for (const auto& level : asks) marketData->publish(MarketDataKind::LEVEL, Side::SELL, symbol, level.price, 0.0);
+    }
+
+    // clear() keeps vector capacity and hash-table buckets, so the next session starts warm
+    bids.clear();
+    asks.clear();
+    peggedBids.primary.clear();
+    peggedBids.mid.clear();
+    peggedAsks.primary.clear();
+    peggedAsks.mid.clear();
+    idToLocation.clear();
+    for (auto& ladder : bidBuckets) ladder = BucketLadder{};
+    for (auto& ladder : askBuckets) ladder = BucketLadder{};
+
+    nextPriority = 0;
+    bookDigest = 0;
+    lastMatchedPrice.store(0.0, std::memory_order_relaxed);
+
+    std::unique_lock lock(shadowMutex);
+    for (auto& shadow : shadows) {
+        shadow.bids.clear();
+        shadow.asks.clear();
+        for (auto& grouped : shadow.groupedBids) grouped.clear();
+        for (auto& grouped : shadow.groupedAsks) grouped.clear();
+        shadow.sequence = 0;
+        shadow.digest = 0;
+        shadow.epoch = 0;
+        shadow.marketDataSeq = marketData ? marketData->getLastSequence() : 0; // The feed keeps counting
+    }
+    shadowHead = 0;
+
+    // Sequences restart at 0, so old renderings could otherwise match again
+    std::unique_lock cacheLock(renderMutex);
+    renderCache.fill({});
+}
+
+std::optional<RestingState> OrderBook::getRestingState(OrderID id) const {
+    auto itLoc = idToLocation.find(id);
+    if (itLoc == idToLocation.end()) return std::nullopt;
+    const OrderEntry& entry = *itLoc->second.it;
+    return RestingState{entry.remainingQuantity, entry.hiddenQuantity, entry.priority};
+}
+
+void OrderBook::bulkLoad(std::vector<RestingEntry> entries) {
+    idToLocation.reserve(idToLocation.size() + entries.size());
+
+    // Pegs first, then the ladder in book order: side, best price first, time priority
+    auto ladder = std::partition(entries.begin(), entries.end(),
+        [](const RestingEntry& e) { return e.order->type == OrderType::PEGGED; });
+    std::sort(entries.begin(), ladder, [](const RestingEntry& x, const RestingEntry& y) {
+        return x.state.priority < y.state.priority;
+    });
+    std::sort(ladder, entries.end(), [](const RestingEntry& x, const RestingEntry& y) {
+        if (x.order->side != y.order->side) return x.order->side == Side::BUY;
+        if (x.order->price != y.order->price) {
+            return (x.order->side == Side::BUY) ? x.order->price > y.order->price : x.order->price < y.order->price;
+        }
+        return x.state.priority < y.state.priority;
+    });
+
+    auto admit = [this](const RestingEntry& e) {
+        OrderEntry entry{e.state.displayed, e.order, e.state.hidden, e.state.priority};
+        bookDigest += entryDigest(entry);
+        nextPriority = std::max(nextPriority, e.state.priority + 1);
+        return entry;
+    };
+    for (auto it = entries.begin(); it != ladder; ++it) {
+        const Order& order = *it->order;
+        auto& lane = ((order.side == Side::BUY) ? peggedBids : peggedAsks).lane(order.pegType);
+        lane.push_back(admit(*it));
+        idToLocation[order.orderID] = { std::prev(lane.end()), 0.0, order.side, order.pegType };
+    }
+
+    auto byPriority = [](const OrderEntry& x, const OrderEntry& y) { return x.priority < y.priority; };
+    // Entries reach a level in priority order, except across epsilon-equal prices or when the
+    // level already held orders. Such levels are marked and each is sorted once at the end.
+    auto outOfOrder = [](const PriceLevel& level) {
+        return level.entries.size() > 1 && std::prev(level.entries.end(), 2)->priority > level.entries.back().priority;
+    };
+
+    // A book that already has levels takes the sorted entries one level lookup at a time
+    if (!bids.empty() || !asks.empty()) {
+        std::vector<std::pair<Side, double>> dirty; // Level iterators do not survive later inserts
+        for (auto it = ladder; it != entries.end(); ++it) {
+            const Order& order = *it->order;
+            auto level = levelFor(order.side, order.price);
+            OrderEntry entry = admit(*it);
+            adjustLevelVolume(order.side, *level, entry.remainingQuantity);
+            level->entries.push_back(std::move(entry));
+            idToLocation[order.orderID] = { std::prev(level->entries.end()), level->price, order.side };
+            if (outOfOrder(*level) && (dirty.empty() || dirty.back() != std::pair{order.side, level->price})) {
+                dirty.emplace_back(order.side, level->price);
+            }
+        }
+        // list::sort relinks nodes, so the iterators in idToLocation stay valid
+        for (auto [side, price] : dirty) levelFor(side, price)->entries.sort(byPriority);
+        publishShadow();
+        return;
+    }
+
+    // Empty ladder: levels come out already in book order, so each side is built by appending.
+    // A level is keyed by its first price, exactly as the append loop below compares, so an
+    // epsilon-chained run of prices is counted as the levels it will actually produce.
+    auto countLevels = [](auto first, auto last) {
+        size_t levels = 0;
+        double anchor = 0.0;
+        for (; first != last; ++first) {
+            if (levels == 0 || !Precision::equal(anchor, first->order->price)) {
+                anchor = first->order->price;
+                ++levels;
+            }
+        }
+        return levels;
+    };
+    auto firstAsk = std::find_if(ladder, entries.end(), [](const RestingEntry& e) { return e.order->side == Side::SELL; });
+    bids.reserve(countLevels(ladder, firstAsk));
+    asks.reserve(countLevels(firstAsk, entries.end()));
+
+    std::vector<std::pair<Side, size_t>> dirty; // Level indices: valid even if a side regrows
+    for (auto it = ladder; it != entries.end(); ++it) {
+        const Order& order = *it->order;
+        auto& levels = (order.side == Side::BUY) ? bids : asks;
+        if (levels.empty() || !Precision::equal(levels.back().price, order.price)) {
+            levels.push_back(PriceLevel{order.price, 0.0, {}});
+        }
+        PriceLevel& level = levels.back();
+        level.entries.push_back(admit(*it));
+        idToLocation[order.orderID] = { std::prev(level.entries.end()), level.price, order.side };
+        std::pair<Side, size_t> at{order.side, levels.size() - 1};
+        if (outOfOrder(level) && (dirty.empty() || dirty.back() != at)) dirty.push_back(at);
+    }
+    for (auto [side, index] : dirty) ((side == Side::BUY) ? bids : asks)[index].entries.sort(byPriority);
+
+    // One volume update per level (feeds depth buckets and market data)
+    for (Side side : {Side::BUY, Side::SELL}) {
+        for (PriceLevel& level : (side == Side::BUY) ? bids : asks) {
+            double volume = 0.0;
+            for (const OrderEntry& entry : level.entries) volume += entry.remainingQuantity;
+            adjustLevelVolume(side, level, volume);
+        }
+    }
+    publishShadow();
+}
+
+BookDigest OrderBook::getDigest() const {
+    std::shared_lock lock(shadowMutex);
+    return { shadows[shadowHead].sequence, shadows[shadowHead].digest };
 }
\ No newline at end of file
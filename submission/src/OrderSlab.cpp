@@ -0,0 +1,150 @@
+#include "OrderSlab.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+    // Header, undo log head, records and undo entries each start on their own cache line
+    constexpr size_t UNDO_OFFSET = 64;
+    constexpr size_t RECORDS_OFFSET = UNDO_OFFSET + (sizeof(SlabUndo) + 63) / 64 * 64;
+    static_assert(sizeof(SlabHeader) <= UNDO_OFFSET);
+
+    size_t undoEntriesOffset(size_t capacity) {
+        return (RECORDS_OFFSET + capacity * sizeof(SlabRecord) + 63) / 64 * 64;
+    }
+}
+
+OrderSlab::~OrderSlab() {
+    close();
+}
+
+void OrderSlab::close() {
+    if (base) munmap(base, mappedBytes);
+    if (fd >= 0) ::close(fd);
+    base = nullptr;
+    head = nullptr;
+    undo = nullptr;
+    records = nullptr;
+    undoEntries = nullptr;
+    fd = -1;
+    mappedBytes = 0;
+}
+
+std::string OrderSlab::open(const std::string& path, size_t capacity) {
+    close();
+    if (capacity == 0 || capacity >= NO_SLOT) return "Invalid slab capacity";
+
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) return "Cannot open slab file";
+
+    struct stat st{};
+    if (fstat(fd, &st) != 0) { close(); return "Cannot stat slab file"; }
+
+    // The undo entries sit past the records; untouched pages stay sparse
+    size_t bytes = undoEntriesOffset(capacity) + capacity * sizeof(SlabUndoEntry);
+    bool fresh = (st.st_size == 0);
+    if (fresh) {
+        if (ftruncate(fd, static_cast<off_t>(bytes)) != 0) { close(); return "Cannot size slab file"; }
+    } else if (static_cast<size_t>(st.st_size) != bytes) {
+        close();
+        return "Slab size does not match capacity";
+    }
+
+    base = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED) { base = nullptr; close(); return "Cannot map slab file"; }
+    mappedBytes = bytes;
+    head = static_cast<SlabHeader*>(base);
+    undo = reinterpret_cast<SlabUndo*>(static_cast<char*>(base) + UNDO_OFFSET);
+    records = reinterpret_cast<SlabRecord*>(static_cast<char*>(base) + RECORDS_OFFSET);
+    undoEntries = reinterpret_cast<SlabUndoEntry*>(static_cast<char*>(base) + undoEntriesOffset(capacity));
+    stagedIn.assign(capacity, 0);
+    repaired = false;
+
+    if (fresh) {
+        *head = SlabHeader{MAGIC, LAYOUT_VERSION, sizeof(SlabRecord), capacity, 0, NO_SLOT, 0, 0, 0};
+        live = 0;
+        return {};
+    }
+    if (head->magic != MAGIC || head->layoutVersion != LAYOUT_VERSION ||
+        head->recordSize != sizeof(SlabRecord) || head->capacity != capacity) {
+        close();
+        return "Slab layout mismatch";
+    }
+    if (head->commitSequence % 2 != 0) {
+        // Cut off mid-request. Replaying is idempotent, so a crash in here just repeats it
+        if (undo->clearing) {
+            for (uint32_t slot = 0; slot < undo->highWater; ++slot) records[slot].inUse = 0;
+            head->highWater = 0;
+            head->freeHead = NO_SLOT;
+        } else {
+            // Backwards, so a slot's oldest pre-image is the one left standing
+            for (uint32_t i = undo->count; i-- > 0;) records[undoEntries[i].slot] = undoEntries[i].image;
+            head->highWater = undo->highWater;
+            head->freeHead = undo->freeHead;
+        }
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+        ++head->commitSequence;
+        repaired = true;
+    }
+    live = 0;
+    for (uint32_t slot = 0; slot < head->highWater; ++slot) live += records[slot].inUse;
+    return {};
+}
+
+void OrderSlab::stage(uint32_t slot) {
+    // The first pre-image within a request is the one to restore; later ones add nothing
+    if (stagedIn[slot] == head->commitSequence) return;
+    stagedIn[slot] = head->commitSequence;
+
+    SlabUndoEntry& entry = undoEntries[undo->count];
+    entry.slot = slot;
+    entry.image = records[slot];
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    ++undo->count;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+}
+
+uint32_t OrderSlab::allocate() {
+    uint32_t slot;
+    if (head->freeHead != NO_SLOT) {
+        slot = head->freeHead;
+        stage(slot);
+        head->freeHead = records[slot].nextFree;
+    } else if (head->highWater < head->capacity) {
+        slot = head->highWater;
+        stage(slot);
+        ++head->highWater;
+    } else {
+        return NO_SLOT;
+    }
+    records[slot].inUse = 1;
+    ++live;
+    return slot;
+}
+
+void OrderSlab::release(uint32_t slot) {
+    stage(slot);
+    records[slot].inUse = 0;
+    --live;
+    records[slot].nextFree = head->freeHead;
+    head->freeHead = slot;
+}
+
+void OrderSlab::clear() {
+    // Rolled forward on attach if cut off: the log head still holds the old highWater.
+    // Touches only the slots ever handed out; the rest of the file stays sparse
+    undo->clearing = 1;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    uint32_t used = head->highWater;
+    head->highWater = 0;
+    head->freeHead = NO_SLOT;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    for (uint32_t slot = 0; slot < used; ++slot) records[slot].inUse = 0;
+    live = 0;
+}
+
+void OrderSlab::flush() {
+    if (base) msync(base, mappedBytes, MS_ASYNC);
+}
@@ -0,0 +1,42 @@
+#include "SnapshotRender.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+std::string renderSnapshotText(const OrderBookSnapshot& snap) {
+    std::ostringstream out;
+    out << "\n--- MARKET: " << snap.symbol.c_str() << " (Seq: " << snap.updateSeq << ") ---\n";
+    out << std::setw(10) << "Price" << " | " << std::setw(10) << "Volume" << "\n";
+    out << "---------------------------\n";
+
+    for (auto it = snap.asks.rbegin(); it != snap.asks.rend(); ++it) {
+        out << "\033[1;31m" << std::setw(10) << it->price << "\033[0m | "
+            << std::setw(10) << it->quantity << "\n";
+    }
+    out << "  ---------- SPREAD ----------\n";
+    for (const auto& level : snap.bids) {
+        out << "\033[1;32m" << std::setw(10) << level.price << "\033[0m | "
+            << std::setw(10) << level.quantity << "\n";
+    }
+    out << "---------------------------\n\n";
+    return std::move(out).str();
+}
+
+std::string renderSnapshotBinary(const OrderBookSnapshot& snap) {
+    SnapshotWireHeader header{SnapshotWireHeader::MAGIC,
+                              static_cast<uint16_t>(std::min<size_t>(snap.bids.size(), UINT16_MAX)),
+                              static_cast<uint16_t>(std::min<size_t>(snap.asks.size(), UINT16_MAX)),
+                              snap.symbol, snap.updateSeq, snap.digest, snap.epoch, snap.marketDataSeq};
+
+    std::string bytes(sizeof(header) + (header.bidCount + header.askCount) * sizeof(BookLevel), '\0');
+    char* cursor = bytes.data();
+    std::memcpy(cursor, &header, sizeof(header));
+    cursor += sizeof(header);
+    // An empty side may have a null data(), which memcpy must not see even for zero bytes
+    if (header.bidCount > 0) std::memcpy(cursor, snap.bids.data(), header.bidCount * sizeof(BookLevel));
+    cursor += header.bidCount * sizeof(BookLevel);
+    if (header.askCount > 0) std::memcpy(cursor, snap.asks.data(), header.askCount * sizeof(BookLevel));
+    return bytes;
+}
@@ -1,5 +1,12 @@
 #include "TradingEngine.hpp"
 
+#include <bit>
+#include <cmath>
+#include <filesystem>
+#include <format>
+#include <thread>
+#include <unordered_set>
+
 TradingEngine::TradingEngine() : nextExecId(1000000) {}
 
 // ============================================================================
@@ -16,6 +23,7 @@ EngineResponse TradingEngine::submitOrder(const LimitOrderRequest& req) {
         req.side, OrderType::LIMIT, OrderStatus::ACTIVE, 
         req.symbol, req.tag
     );
+    order->session = req.session;
     return processOrder(order);
 }
 
@@ -28,11 +36,240 @@ EngineResponse TradingEngine::submitOrder(const MarketOrderRequest& req) {
         req.side, OrderType::MARKET, OrderStatus::ACTIVE, 
         req.symbol, req.tag
     );
+    order->session = req.session;
+    return processOrder(order);
+}
+
+EngineResponse TradingEngine::submitOrder(const IcebergOrderRequest& req) {
+    if (!Precision::isPositive(req.displayQuantity) || req.displayQuantity > req.quantity) {
+        return EngineResponse::Error(EngineStatusCode::VALIDATION_FAILURE, "Invalid display quantity");
+    }
+    auto val = validateCommon(req.symbol, req.quantity, req.price, req.tag); 
+    if (!val.isSuccess()) return val;
+
+    // An iceberg takes liquidity with its full size; only the resting part is sliced
+    auto order = std::make_shared<Order>(
+        req.price, req.quantity, req.quantity, 0.0, 
+        req.side, OrderType::LIMIT, OrderStatus::ACTIVE, 
+        req.symbol, req.tag
+    );
+    order->displayQuantity = req.displayQuantity;
+    order->session = req.session;
     return processOrder(order);
 }
 
+EngineResponse TradingEngine::submitOrder(const PeggedOrderRequest& req) {
+    if (req.peg == PegType::NONE) {
+        return EngineResponse::Error(EngineStatusCode::VALIDATION_FAILURE, "Invalid peg type");
+    }
+    // No price to band-check: the effective price always sits at or inside the BBO
+    auto val = validateCommon(req.symbol, req.quantity, std::nullopt, req.tag);
+    if (!val.isSuccess()) return val;
+
+    auto order = std::make_shared<Order>(
+        0.0, req.quantity, req.quantity, 0.0, 
+        req.side, OrderType::PEGGED, OrderStatus::ACTIVE, 
+        req.symbol, req.tag
+    );
+    order->pegType = req.peg;
+    order->session = req.session;
+    return processOrder(order);
+}
+
+std::vector<EngineResponse> TradingEngine::submitBatch(const std::vector<LimitOrderRequest>& batch) {
+    // Gather: one row per order, book facts looked up once per symbol
+    struct BookLimits { double low, high; uint8_t fragmented; };
+    std::unordered_map<Symbol, BookLimits> limits;
+    ValidationBatch columns;
+    columns.resize(batch.size());
+    for (size_t i = 0; i < batch.size(); ++i) {
+        const LimitOrderRequest& req = batch[i];
+        auto [it, fresh] = limits.try_emplace(req.symbol, BookLimits{-HUGE_VAL, HUGE_VAL, 0});
+        if (fresh) {
+            if (OrderBook* book = tryGetBook(req.symbol)) {
+                it->second.fragmented = book->getPriceLevelCount() >= Config::MAX_PRICE_LEVELS;
+                if (double lastPrice = book->getLastPrice(); lastPrice > 0.0) {
+                    double band = lastPrice * Config::PRICE_BAND_PERCENT;
+                    it->second.low = lastPrice - band;
+                    it->second.high = lastPrice + band;
+                }
+            }
+        }
+        columns.quantity[i] = req.quantity;
+        columns.price[i] = req.price;
+        columns.bandLow[i] = it->second.low;
+        columns.bandHigh[i] = it->second.high;
+        columns.tagLength[i] = static_cast<uint32_t>(req.tag.size());
+        columns.symbolEmpty[i] = req.symbol.empty();
+        columns.fragmented[i] = it->second.fragmented;
+    }
+    const size_t rejected = validateBatch(columns);
+
+    auto rejection = [](BatchReject reason) {
+        switch (reason) {
+            case BatchReject::QUANTITY:    return EngineResponse::Error(EngineStatusCode::VALIDATION_FAILURE, "Invalid quantity");
+            case BatchReject::TAG:         return EngineResponse::Error(EngineStatusCode::VALIDATION_FAILURE, "Tag too long");
+            case BatchReject::SYMBOL:      return EngineResponse::Error(EngineStatusCode::VALIDATION_FAILURE, "Invalid symbol");
+            case BatchReject::CAPACITY:    return EngineResponse::Error(EngineStatusCode::VALIDATION_FAILURE, "Engine at max capacity");
+            case BatchReject::STORE_FULL:  return EngineResponse::Error(EngineStatusCode::VALIDATION_FAILURE, "Order store full");
+            case BatchReject::PRICE_RANGE: return EngineResponse::Error(EngineStatusCode::VALIDATION_FAILURE, "Price out of range");
+            case BatchReject::FRAGMENTED:  return EngineResponse::Error(EngineStatusCode::VALIDATION_FAILURE, "Orderbook too fragmented");
+            case BatchReject::PRICE_BAND:  return EngineResponse::Error(EngineStatusCode::PRICE_OUT_OF_BAND, "Price outside banding limits");
+            case BatchReject::NONE:        break;
+        }
+        return EngineResponse::Success("");
+    };
+
+    // Rejected rows straight from the mask: they touch no engine state
+    std::vector<EngineResponse> responses(batch.size());
+    for (size_t word = 0; word < columns.rejectMask.size(); ++word) {
+        for (uint64_t bits = columns.rejectMask[word]; bits != 0; bits &= bits - 1) {
+            size_t i = word * 64 + static_cast<size_t>(std::countr_zero(bits));
+            responses[i] = rejection(columns.reason[i]);
+        }
+    }
+    if (rejected == batch.size()) return responses;
+
+    // Survivors are admitted in input order while registry capacity lasts (one lock for the whole batch)
+    size_t capacity;
+    {
+        std::shared_lock lock(registryMutex);
+        capacity = Config::MAX_GLOBAL_ORDERS - std::min<size_t>(idRegistry.size(), Config::MAX_GLOBAL_ORDERS);
+    }
+
+    for (size_t word = 0; word < columns.rejectMask.size(); ++word) {
+        size_t base = word * 64;
+        uint64_t rows = (batch.size() - base >= 64) ? ~0ULL : (1ULL << (batch.size() - base)) - 1;
+        for (uint64_t bits = ~columns.rejectMask[word] & rows; bits != 0; bits &= bits - 1) {
+            size_t i = base + static_cast<size_t>(std::countr_zero(bits));
+            if (capacity == 0) {
+                responses[i] = rejection(BatchReject::CAPACITY);
+                continue;
+            }
+            if (store && store->isFull()) {
+                responses[i] = rejection(BatchReject::STORE_FULL);
+                continue;
+            }
+
+            const LimitOrderRequest& req = batch[i];
+            auto order = std::make_shared<Order>(
+                req.price, req.quantity, req.quantity, 0.0,
+                req.side, OrderType::LIMIT, OrderStatus::ACTIVE,
+                req.symbol, req.tag
+            );
+            order->session = req.session;
+            responses[i] = processOrder(order);
+            if (responses[i].isSuccess()) --capacity;
+        }
+    }
+    return responses;
+}
+
+EngineResponse TradingEngine::seedBook(const Symbol& symbol, const std::vector<LimitOrderRequest>& orders) {
+    // Capacity for the whole seed up front, under one lock: persist() must never run out of slots
+    {
+        std::shared_lock lock(registryMutex);
+        if (idRegistry.size() + orders.size() > static_cast<size_t>(Config::MAX_GLOBAL_ORDERS)) {
+            return EngineResponse::Error(EngineStatusCode::VALIDATION_FAILURE, "Engine at max capacity");
+        }
+    }
+    if (store && store->getFreeSlots() < orders.size()) {
+        return EngineResponse::Error(EngineStatusCode::VALIDATION_FAILURE, "Order store full");
+    }
+
+    double bestBid = 0.0, bestAsk = Config::MAX_ORDER_PRICE + 1.0;
+    std::vector<double> bidPrices, askPrices;
+    for (const auto& req : orders) {
+        if (req.symbol != symbol) return EngineResponse::Error(EngineStatusCode::VALIDATION_FAILURE, "Seed order for another symbol");
+        auto val = validateCommon(req.symbol, req.quantity, req.price, req.tag, false);
+        if (!val.isSuccess()) return val;
+        if (req.side == Side::BUY) {
+            bestBid = std::max(bestBid, req.price);
+            bidPrices.push_back(req.price);
+        } else {
+            bestAsk = std::min(bestAsk, req.price);
+            askPrices.push_back(req.price);
+        }
+    }
+    // validateCommon saw an empty book, so the fragmentation guard is applied to the seed as a
+    // whole: levels are counted as bulkLoad() builds them, keyed by each level's first price
+    auto countLevels = [](std::vector<double>& prices) {
+        std::sort(prices.begin(), prices.end());
+        size_t levels = 0;
+        for (size_t i = 0, anchor = 0; i < prices.size(); ++i) {
+            if (levels == 0 || !Precision::equal(prices[anchor], prices[i])) {
+                anchor = i;
+                ++levels;
+            }
+        }
+        return levels;
+    };
+    if (countLevels(bidPrices) + countLevels(askPrices) > static_cast<size_t>(Config::MAX_PRICE_LEVELS)) {
+        return EngineResponse::Error(EngineStatusCode::VALIDATION_FAILURE, "Orderbook too fragmented");
+    }
+    // Matching treats epsilon-equal prices as one, and so does journal replay of the seed
+    if (bestBid >= bestAsk || Precision::equal(bestBid, bestAsk)) {
+        return EngineResponse::Error(EngineStatusCode::VALIDATION_FAILURE, "Seed orders cross");
+    }
+
+    OrderBook* book = getOrAddBook(symbol);
+    if (book->getOrderCount() > 0) return EngineResponse::Error(EngineStatusCode::VALIDATION_FAILURE, "Book not empty");
+
+    std::vector<RestingEntry> entries;
+    entries.reserve(orders.size());
+    {
+        std::unique_lock lock(registryMutex);
+        std::unordered_set<std::string_view> batchTags;
+        batchTags.reserve(orders.size());
+        for (const auto& req : orders) {
+            if ((tagFilter.mayContain(req.tag) && findTag(req.tag)) || !batchTags.insert(req.tag).second) {
+                return EngineResponse::Error(EngineStatusCode::DUPLICATE_TAG, "Tag collision");
+            }
+        }
+        idRegistry.reserve(idRegistry.size() + orders.size());
+        tagToId.reserve(tagToId.size() + orders.size());
+        for (const auto& req : orders) {
+            auto order = std::make_shared<Order>(
+                req.price, req.quantity, req.quantity, 0.0,
+                req.side, OrderType::LIMIT, OrderStatus::ACTIVE,
+                req.symbol, req.tag
+            );
+            order->session = req.session;
+            tagFilter.insert(order->tag);
+            tagToId.emplace(order->tag, order->orderID);
+            idRegistry[order->orderID] = order;
+            entries.push_back({order, {req.quantity, 0.0, static_cast<SeqNum>(entries.size())}});
+        }
+    }
+    // Replaying these as plain submissions reproduces the seed: nothing crosses
+    if (journal) {
+        for (const auto& entry : entries) journal->appendOrder(*entry.order);
+    }
+    book->bulkLoad(entries);
+    if (store) {
+        // One request in the store: a crash part-way leaves no seed at all
+        store->beginWrite();
+        for (const auto& entry : entries) persist(*entry.order, *book);
+        store->endWrite();
+    }
+    // Accepted like any other order: an audit ACCEPT and a subscriber ACK each, and no fills
+    const bool subscribed = subscriberCount.load(std::memory_order_relaxed) > 0;
+    if (audit || subscribed) {
+        const MatchResult unmatched{};
+        for (const auto& entry : entries) {
+            if (audit) auditExecution(unmatched, *entry.order);
+            if (subscribed) publishUpdates(unmatched, *entry.order);
+        }
+    }
+
+    EngineResponse resp = EngineResponse::Success("Seeded " + std::to_string(entries.size()) + " orders");
+    resp.digest = book->getDigest();
+    return resp;
+}
+
 EngineResponse TradingEngine::validateCommon(const Symbol& symbol, double quantity, 
-                                             std::optional<double> price, const std::string& tag) {
+                                             std::optional<double> price, const std::string& tag,
+                                             bool checkCapacity) {
     if (quantity <= 0 || quantity > Config::MAX_ORDER_QTY) {
         return EngineResponse::Error(EngineStatusCode::VALIDATION_FAILURE, "Invalid quantity");
     }
@@ -45,13 +282,17 @@ EngineResponse TradingEngine::validateCommon(const Symbol& symbol, double quanti
         return EngineResponse::Error(EngineStatusCode::VALIDATION_FAILURE, "Invalid symbol");
     }
 
-    {
+    if (checkCapacity) {
         std::shared_lock lock(registryMutex);
         if (idRegistry.size() >= Config::MAX_GLOBAL_ORDERS) {
             return EngineResponse::Error(EngineStatusCode::VALIDATION_FAILURE, "Engine at max capacity");
         }
     }
 
+    if (checkCapacity && store && store->isFull()) {
+        return EngineResponse::Error(EngineStatusCode::VALIDATION_FAILURE, "Order store full");
+    }
+
     if (price.has_value()) {
         double p = *price;
         if (p < Config::MIN_ORDER_PRICE || p > Config::MAX_ORDER_PRICE) {
@@ -79,41 +320,115 @@ EngineResponse TradingEngine::validateCommon(const Symbol& symbol, double quanti
 EngineResponse TradingEngine::processOrder(std::shared_ptr<Order> order) {
     {
         std::unique_lock lock(registryMutex);
-        if (tagToId.contains(order->tag)) {
+        // Fresh tags (the common case) are settled by one filter block; only maybes pay for the maps
+        if (tagFilter.mayContain(order->tag) && findTag(order->tag)) {
             return EngineResponse::Error(EngineStatusCode::DUPLICATE_TAG, "Tag collision");
         }
-        tagToId[order->tag] = order->orderID;
+        tagFilter.insert(order->tag);
+        tagToId.emplace(order->tag, order->orderID);
         idRegistry[order->orderID] = order;
     }
+    if (journal) journal->appendOrder(*order);
 
     OrderBook* book = getOrAddBook(order->symbol);
     MatchResult result = book->execute(order, nextExecId);
+    queueTerminal(result, *order);
+    if (store) persistExecution(result, *order, *book);
+    if (audit) auditExecution(result, *order);
+    if (!result.fills.empty() && openSessions.load(std::memory_order_relaxed) > 0) routeExecutions(result, *order);
+    if (subscriberCount.load(std::memory_order_relaxed) > 0) publishUpdates(result, *order);
     
-    return finalizeExecution(result, order);
+    return finalizeExecution(std::move(result), order);
 }
 
-EngineResponse TradingEngine::finalizeExecution(const MatchResult& result, std::shared_ptr<Order> taker) {
+EngineResponse TradingEngine::finalizeExecution(MatchResult result, std::shared_ptr<Order> taker) {
     std::string msg;
     if (taker->status == OrderStatus::FILLED) {
         msg = "Order fully filled";
     } else if (result.fills.empty()) {
-        msg = (taker->type == OrderType::MARKET) ? "Market order cancelled (No Liquidity)" : "Order posted to book";
+        if (taker->type == OrderType::MARKET) msg = "Market order cancelled (No Liquidity)";
+        else if (taker->type == OrderType::PEGGED) msg = "Pegged order posted to book";
+        else msg = "Order posted to book";
     } else {
         msg = "Order partially filled";
     }
 
-    return EngineResponse::Success(std::move(msg), taker);
+    EngineResponse resp = EngineResponse::Success(std::move(msg), taker);
+    resp.digest = result.book;
+    resp.fills = std::move(result.fills);
+    return resp;
 }
 
 // ============================================================================
 // SECTION 2: MANAGEMENT & INFRASTRUCTURE
 // ============================================================================
 
-EngineResponse TradingEngine::internalCancel(OrderID orderId) {
-    auto it = idRegistry.find(orderId);
-    if (it == idRegistry.end()) return EngineResponse::Error(EngineStatusCode::ORDER_ID_NOT_FOUND, "ID missing");
+void TradingEngine::queueTerminal(const MatchResult& result, const Order& taker) {
+    bool takerDone = taker.isFinished();
+    bool makerDone = std::ranges::any_of(result.fills, [](const FillRecord& f) { return Precision::isZero(f.makerRemaining); });
+    if (!takerDone && !makerDone) return; // Common resting case: no lock taken
 
-    std::shared_ptr<Order> order = it->second;
+    std::unique_lock lock(registryMutex);
+    for (const auto& fill : result.fills) {
+        if (Precision::isZero(fill.makerRemaining)) terminalOrders.push_back(fill.makerOrderId);
+    }
+    if (takerDone) terminalOrders.push_back(taker.orderID);
+}
+
+void TradingEngine::auditExecution(const MatchResult& result, const Order& taker) {
+    uint64_t ts = AuditLog::now();
+    audit->record({ts, AuditKind::ACCEPT, taker.side, taker.symbol, taker.orderID, 0, 0,
+                   taker.price, taker.originalQuantity});
+    for (const auto& fill : result.fills) {
+        audit->record({ts, AuditKind::FILL, taker.side, taker.symbol, fill.takerOrderId, fill.makerOrderId,
+                       fill.executionId, fill.price, fill.quantity});
+    }
+    if (taker.status == OrderStatus::CANCELLED) { // Market remainder with no liquidity left
+        audit->record({ts, AuditKind::EXPIRE, taker.side, taker.symbol, taker.orderID, 0, 0,
+                       taker.price, taker.remainingQuantity});
+    }
+}
+
+void TradingEngine::routeExecutions(const MatchResult& result, const Order& taker) {
+    std::shared_lock lock(sessionMutex);
+    auto egressOf = [this](SessionID session) -> SessionEgress* {
+        if (session == 0) return nullptr;
+        auto it = sessions.find(session);
+        return (it == sessions.end()) ? nullptr : it->second.get();
+    };
+
+    SessionEgress* takerOut = egressOf(taker.session);
+    Side makerSide = (taker.side == Side::BUY) ? Side::SELL : Side::BUY;
+    double takerLeaves = taker.originalQuantity;
+    for (const auto& fill : result.fills) {
+        Precision::subtract_or_zero(takerLeaves, fill.quantity);
+        if (takerOut) {
+            takerOut->publish({taker.session, fill.takerOrderId, fill.makerOrderId, fill.executionId,
+                               taker.symbol, taker.side, false, fill.price, fill.quantity, takerLeaves});
+        }
+        if (SessionEgress* makerOut = egressOf(fill.makerSession)) {
+            makerOut->publish({fill.makerSession, fill.makerOrderId, fill.takerOrderId, fill.executionId,
+                               taker.symbol, makerSide, true, fill.price, fill.quantity, fill.makerRemaining});
+        }
+    }
+}
+
+EngineResponse TradingEngine::internalCancel(OrderID orderId, const Symbol* expectedSymbol) {
+    std::shared_ptr<Order> order;
+    {
+        std::shared_lock lock(registryMutex);
+        auto it = idRegistry.find(orderId);
+        if (it == idRegistry.end()) {
+            if (archive.contains(orderId)) return EngineResponse::Error(EngineStatusCode::ALREADY_TERMINAL, "Already terminal");
+            return EngineResponse::Error(EngineStatusCode::ORDER_ID_NOT_FOUND, "ID missing");
+        }
+        order = it->second;
+    }
+
+    // The symbol never changes after insert, so this check holds for the whole cancel
+    if (expectedSymbol && order->symbol != *expectedSymbol) {
+        return EngineResponse::Error(EngineStatusCode::VALIDATION_FAILURE, "Order is not in this symbol's book");
+    }
     if (order->isFinished()) return EngineResponse::Error(EngineStatusCode::ALREADY_TERMINAL, "Already terminal");
 
     if (OrderBook* book = tryGetBook(order->symbol)) {
@@ -123,12 +438,94 @@ EngineResponse TradingEngine::internalCancel(OrderID orderId) {
             std::unique_lock lock(order->stateMutex); 
             order->status = OrderStatus::CANCELLED;
             order->remainingQuantity = *cancelledQty;
-            return EngineResponse::Success("Cancelled");
+            lock.unlock();
+            {
+                std::unique_lock registryLock(registryMutex);
+                terminalOrders.push_back(order->orderID);
+            }
+            if (journal) journal->appendCancel(order->orderID);
+            if (store) {
+                store->beginWrite();
+                persist(*order, *book);
+                store->endWrite();
+            }
+            if (audit) {
+                audit->record({AuditLog::now(), AuditKind::CANCEL, order->side, order->symbol,
+                               order->orderID, 0, 0, order->price, *cancelledQty});
+            }
+            if (subscriberCount.load(std::memory_order_relaxed) > 0) {
+                notify({OrderUpdateKind::CANCEL, order->orderID, order->session, order->symbol, order->side,
+                        0, 0.0, 0.0, *cancelledQty});
+            }
+            EngineResponse resp = EngineResponse::Success("Cancelled");
+            resp.digest = book->getDigest();
+            return resp;
         }
     }
     return EngineResponse::Error(EngineStatusCode::ORDER_ID_NOT_FOUND, "Not active in book");
 }
 
+void TradingEngine::reset() {
+    {
+        std::unique_lock lock(registryMutex);
+        idRegistry.clear(); // Buckets survive clear(); only the Order objects are released
+        tagToId.clear();
+        archivedTags.clear();
+        tagFilter.clear();
+        archive.clear();
+        terminalOrders.clear();
+    }
+    if (store) {
+        store->beginWrite();
+        store->clear();
+        store->endWrite();
+    }
+    if (journal) journal->clear();
+    {
+        std::shared_lock lock(bookshelfMutex);
+        for (auto& [symbol, book] : symbolBooks) book->reset();
+    }
+    nextExecId.store(1000000, std::memory_order_relaxed);
+    globalEpoch.store(0, std::memory_order_relaxed);
+}
+
+size_t TradingEngine::archiveTerminalOrders(size_t maxOrders) {
+    std::unique_lock lock(registryMutex);
+    size_t moved = 0;
+    while (moved < maxOrders && !terminalOrders.empty()) {
+        OrderID id = terminalOrders.front();
+        terminalOrders.pop_front();
+
+        auto it = idRegistry.find(id);
+        if (it == idRegistry.end()) continue;
+
+        const Order& o = *it->second;
+        {
+            std::shared_lock stateLock(o.stateMutex);
+            archive.emplace(id, ArchivedOrder{
+                o.timestamp, o.price, o.originalQuantity, o.remainingQuantity, o.cumulativeCost,
+                o.side, o.type, o.status, o.pegType, o.symbol, o.tag
+            });
+        }
+        if (store && o.storeSlot != OrderSlab::NO_SLOT) {
+            // Archived history lives in memory only; the slab keeps live state
+            store->beginWrite();
+            store->release(o.storeSlot);
+            store->endWrite();
+        }
+        // Relink the tag's node into the cold map: no reallocation, and the hot map stays live-sized
+        if (auto node = tagToId.extract(o.tag)) archivedTags.insert(std::move(node));
+        idRegistry.erase(it);
+        ++moved;
+    }
+    return moved;
+}
+
+void TradingEngine::warmBooks() {
+    std::shared_lock lock(bookshelfMutex);
+    for (const auto& [symbol, book] : symbolBooks) book->warmTopOfBook();
+}
+
 OrderBook* TradingEngine::getOrAddBook(const Symbol& symbol) {
     {
         std::shared_lock lock(bookshelfMutex);
@@ -137,10 +534,19 @@ OrderBook* TradingEngine::getOrAddBook(const Symbol& symbol) {
     }
     std::unique_lock lock(bookshelfMutex);
     auto& book = symbolBooks[symbol];
-    if (!book) book = std::make_unique<OrderBook>(symbol);
+    if (!book) {
+        book = std::make_unique<OrderBook>(symbol, globalEpoch);
+        if (marketDataEnabled) book->enableMarketData();
+    }
     return book.get();
 }
 
+std::optional<OrderID> TradingEngine::findTag(const std::string& tag) const {
+    if (auto it = tagToId.find(tag); it != tagToId.end()) return it->second;
+    if (auto it = archivedTags.find(tag); it != archivedTags.end()) return it->second;
+    return std::nullopt;
+}
+
 OrderBook* TradingEngine::tryGetBook(const Symbol& symbol) const {
     std::shared_lock lock(bookshelfMutex);
     auto it = symbolBooks.find(symbol);
@@ -154,7 +560,18 @@ OrderBook* TradingEngine::tryGetBook(const Symbol& symbol) const {
 EngineResponse TradingEngine::getOrder(OrderID id) {
     std::shared_lock lock(registryMutex);
     auto it = idRegistry.find(id);
-    if (it == idRegistry.end()) return EngineResponse::Error(EngineStatusCode::ORDER_ID_NOT_FOUND, "ID missing");
+    if (it == idRegistry.end()) {
+        // Cold path: rebuild a detached copy of an archived order
+        auto arc = archive.find(id);
+        if (arc == archive.end()) return EngineResponse::Error(EngineStatusCode::ORDER_ID_NOT_FOUND, "ID missing");
+        const ArchivedOrder& a = arc->second;
+        auto order = std::make_shared<Order>(
+            id, a.timestamp, a.price, a.originalQuantity, a.remainingQuantity, a.cumulativeCost,
+            a.side, a.type, a.status, a.symbol, a.tag
+        );
+        order->pegType = a.pegType;
+        return EngineResponse::Success("Success", order);
+    }
 
     std::shared_ptr<Order> order = it->second;
     
@@ -176,13 +593,17 @@ EngineResponse TradingEngine::cancelOrder(OrderID id) {
     return internalCancel(id);
 }
 
+EngineResponse TradingEngine::cancelOrder(OrderID id, const Symbol& symbol) {
+    return internalCancel(id, &symbol);
+}
+
 EngineResponse TradingEngine::getOrderByTag(const std::string& tag) {
     OrderID id = 0;
     {
         std::shared_lock lock(registryMutex);
-        auto it = tagToId.find(tag);
-        if (it == tagToId.end()) return EngineResponse::Error(EngineStatusCode::TAG_NOT_FOUND, "Tag not found");
-        id = it->second;
+        auto found = findTag(tag);
+        if (!found) return EngineResponse::Error(EngineStatusCode::TAG_NOT_FOUND, "Tag not found");
+        id = *found;
     }
     return getOrder(id);
 }
@@ -191,9 +612,9 @@ EngineResponse TradingEngine::cancelOrderByTag(const std::string& tag) {
     OrderID id = 0;
     {
         std::shared_lock lock(registryMutex);
-        auto it = tagToId.find(tag);
-        if (it == tagToId.end()) return EngineResponse::Error(EngineStatusCode::TAG_NOT_FOUND, "Tag not found");
-        id = it->second;
+        auto found = findTag(tag);
+        if (!found) return EngineResponse::Error(EngineStatusCode::TAG_NOT_FOUND, "Tag not found");
+        id = *found;
     }
     return internalCancel(id);
 }
@@ -206,4 +627,461 @@ EngineResponse TradingEngine::getOrderBookSnapshot(const Symbol& symbol, size_t
     EngineResponse resp = EngineResponse::Success("Success");
     resp.snapshot = std::move(snap);
     return resp;
-}
\ No newline at end of file
+}
+
+EngineResponse TradingEngine::getBookDigest(const Symbol& symbol) {
+    OrderBook* book = tryGetBook(symbol);
+    if (!book) return EngineResponse::Error(EngineStatusCode::SYMBOL_NOT_FOUND, "Symbol missing");
+
+    BookDigest digest = book->getDigest();
+    EngineResponse resp = EngineResponse::Success(std::format("Digest: {:x} (Seq: {})", digest.digest, digest.sequence));
+    resp.digest = digest;
+    return resp;
+}
+
+EngineResponse TradingEngine::getRenderedSnapshot(const Symbol& symbol, size_t depth, SnapshotFormat format) {
+    OrderBook* book = tryGetBook(symbol);
+    if (!book) return EngineResponse::Error(EngineStatusCode::SYMBOL_NOT_FOUND, "Symbol missing");
+
+    EngineResponse resp = EngineResponse::Success("Success");
+    resp.rendered = book->getRenderedSnapshot(depth, format);
+    return resp;
+}
+
+EngineResponse TradingEngine::getGroupedOrderBookSnapshot(const Symbol& symbol, double bucketSize, size_t depth) {
+    OrderBook* book = tryGetBook(symbol);
+    if (!book) return EngineResponse::Error(EngineStatusCode::SYMBOL_NOT_FOUND, "Symbol missing");
+
+    auto snap = book->getGroupedSnapshot(bucketSize, depth);
+    if (!snap) return EngineResponse::Error(EngineStatusCode::VALIDATION_FAILURE, "Unsupported bucket size");
+    EngineResponse resp = EngineResponse::Success("Success");
+    resp.snapshot = std::move(*snap);
+    return resp;
+}
+
+EngineResponse TradingEngine::getMarketSnapshot(const std::vector<Symbol>& symbols, size_t depth) {
+    std::vector<std::pair<Symbol, OrderBook*>> books;
+    {
+        std::shared_lock lock(bookshelfMutex);
+        if (symbols.empty()) {
+            for (const auto& [sym, book] : symbolBooks) books.emplace_back(sym, book.get());
+            std::ranges::sort(books, {}, &std::pair<Symbol, OrderBook*>::first);
+        } else {
+            for (const auto& sym : symbols) {
+                auto it = symbolBooks.find(sym);
+                if (it == symbolBooks.end()) return EngineResponse::Error(EngineStatusCode::SYMBOL_NOT_FOUND, "Symbol missing");
+                books.emplace_back(sym, it->second.get());
+            }
+        }
+    }
+
+    // A busy book may recycle the version we need before we reach it; retry at a fresh epoch
+    for (int attempt = 0; attempt < Config::SNAPSHOT_CUT_RETRIES; ++attempt) {
+        MarketSnapshot cut{globalEpoch.load(std::memory_order_acquire), {}};
+        cut.books.reserve(books.size());
+
+        bool complete = true;
+        for (const auto& [sym, book] : books) {
+            auto snap = book->getSnapshotAt(cut.epoch, depth);
+            if (!snap) { complete = false; break; }
+            cut.books.push_back(std::move(*snap));
+        }
+
+        if (complete) {
+            EngineResponse resp = EngineResponse::Success("Success");
+            resp.market = std::move(cut);
+            return resp;
+        }
+    }
+    return EngineResponse::Error(EngineStatusCode::SNAPSHOT_UNAVAILABLE, "Books moving too fast for a consistent cut");
+}
+
+// ============================================================================
+// SECTION 4: PERSISTENT ORDER STORE
+// ============================================================================
+
+EngineResponse TradingEngine::attachStore(const std::string& path, size_t capacity) {
+    if (journal) {
+        return EngineResponse::Error(EngineStatusCode::STORE_FAILURE, "Store and journal cannot be combined: each restores the engine on its own");
+    }
+    {
+        std::shared_lock lock(registryMutex);
+        if (!idRegistry.empty() || !archive.empty()) {
+            return EngineResponse::Error(EngineStatusCode::STORE_FAILURE, "Store must be attached to an empty engine");
+        }
+    }
+
+    auto slab = std::make_unique<OrderSlab>();
+    if (std::string err = slab->open(path, capacity); !err.empty()) {
+        return EngineResponse::Error(EngineStatusCode::STORE_FAILURE, std::move(err));
+    }
+    const SlabHeader& header = slab->header();
+
+    // Rebuild from the records: the registry directly, books in one bulkLoad() call each
+    std::unordered_map<Symbol, std::vector<RestingEntry>> resting;
+    size_t restored = 0;
+    {
+        std::unique_lock lock(registryMutex);
+        for (uint32_t slot = 0; slot < slab->getHighWater(); ++slot) {
+            const SlabRecord& rec = slab->at(slot);
+            if (!rec.inUse) continue;
+
+            auto order = std::make_shared<Order>(
+                rec.orderID, rec.timestamp, rec.price, rec.originalQuantity, rec.remainingQuantity,
+                rec.cumulativeCost, static_cast<Side>(rec.side), static_cast<OrderType>(rec.type),
+                static_cast<OrderStatus>(rec.status), Symbol(rec.symbol), std::string(rec.tag)
+            );
+            order->pegType = static_cast<PegType>(rec.pegType);
+            order->displayQuantity = rec.displayQuantity;
+            order->storeSlot = slot;
+            order->session = rec.session;
+
+            idRegistry[order->orderID] = order;
+            tagToId[order->tag] = order->orderID;
+            tagFilter.insert(order->tag);
+            if (order->status == OrderStatus::ACTIVE) {
+                resting[order->symbol].push_back({order, {rec.displayed, rec.hidden, rec.priority}});
+            } else {
+                terminalOrders.push_back(order->orderID);
+            }
+            ++restored;
+        }
+    }
+    for (auto& [symbol, entries] : resting) getOrAddBook(symbol)->bulkLoad(std::move(entries));
+
+    // New identities continue after the last persisted ones
+    auto raise = [](auto& counter, auto floor) {
+        if (counter.load(std::memory_order_relaxed) < floor) counter.store(floor, std::memory_order_relaxed);
+    };
+    raise(Order::globalCounter, header.nextOrderId);
+    raise(nextExecId, header.nextExecId);
+
+    std::string message = "Restored " + std::to_string(restored) + " orders";
+    if (slab->wasRepaired()) message += " (rolled back a half-written request)";
+    store = std::move(slab);
+    return EngineResponse::Success(std::move(message));
+}
+
+void TradingEngine::persist(Order& order, const OrderBook& book) {
+    if (order.storeSlot == OrderSlab::NO_SLOT) {
+        order.storeSlot = store->allocate();
+        if (order.storeSlot == OrderSlab::NO_SLOT) return; // validateCommon rejects new orders when full
+    } else {
+        store->stage(order.storeSlot);
+    }
+
+    SlabRecord& rec = store->at(order.storeSlot);
+    std::optional<RestingState> state = book.getRestingState(order.orderID);
+
+    std::shared_lock lock(order.stateMutex);
+    rec.orderID = order.orderID;
+    rec.timestamp = order.timestamp;
+    rec.priority = state ? state->priority : 0;
+    rec.price = order.price;
+    rec.originalQuantity = order.originalQuantity;
+    rec.remainingQuantity = order.remainingQuantity;
+    rec.displayed = state ? state->displayed : 0.0;
+    rec.hidden = state ? state->hidden : 0.0;
+    rec.displayQuantity = order.displayQuantity;
+    rec.cumulativeCost = order.cumulativeCost;
+    rec.session = order.session;
+    rec.side = static_cast<uint8_t>(order.side);
+    rec.type = static_cast<uint8_t>(order.type);
+    rec.status = static_cast<uint8_t>(order.status);
+    rec.pegType = static_cast<uint8_t>(order.pegType);
+    std::memcpy(rec.symbol, order.symbol.data, sizeof(rec.symbol));
+    size_t tagLen = std::min(order.tag.size(), sizeof(rec.tag) - 1);
+    std::memcpy(rec.tag, order.tag.data(), tagLen);
+    rec.tag[tagLen] = '\0';
+}
+
+void TradingEngine::persistExecution(const MatchResult& result, Order& taker, const OrderBook& book) {
+    store->beginWrite();
+    persist(taker, book);
+    for (const auto& fill : result.fills) {
+        std::shared_ptr<Order> maker;
+        {
+            std::shared_lock lock(registryMutex);
+            auto it = idRegistry.find(fill.makerOrderId);
+            if (it != idRegistry.end()) maker = it->second;
+        }
+        if (maker) persist(*maker, book);
+    }
+
+    SlabHeader& header = store->header();
+    header.nextOrderId = Order::globalCounter.load(std::memory_order_relaxed);
+    header.nextExecId = nextExecId.load(std::memory_order_relaxed);
+    store->endWrite();
+}
+
+void TradingEngine::flushStore() {
+    if (store) store->flush();
+}
+
+SeqNum TradingEngine::getStoreSequence() const {
+    return store ? store->header().commitSequence / 2 : 0;
+}
+
+EngineResponse TradingEngine::attachJournal(const std::string& path, size_t recoveryThreads) {
+    // Records the outgoing journal could not make durable must not vanish with it
+    if (EngineResponse committed = commitJournal(); !committed.isSuccess()) return committed;
+    if (store) {
+        return EngineResponse::Error(EngineStatusCode::JOURNAL_FAILURE, "Store and journal cannot be combined: each restores the engine on its own");
+    }
+    {
+        std::shared_lock lock(registryMutex);
+        if (!idRegistry.empty() || !archive.empty()) {
+            return EngineResponse::Error(EngineStatusCode::JOURNAL_FAILURE, "Journal must be attached to an empty engine");
+        }
+    }
+
+    size_t replayed = 0;
+    if (std::filesystem::exists(path)) {
+        JournalReader reader;
+        if (std::string err = reader.open(path); !err.empty()) {
+            return EngineResponse::Error(EngineStatusCode::JOURNAL_FAILURE, std::move(err));
+        }
+        std::vector<JournalRecord> records;
+        for (JournalRecord rec; reader.next(rec);) records.push_back(std::move(rec));
+        replayed = records.size();
+        recoverFromJournal(std::move(records), recoveryThreads);
+    }
+
+    auto writer = std::make_unique<JournalWriter>();
+    if (std::string err = writer->open(path); !err.empty()) {
+        return EngineResponse::Error(EngineStatusCode::JOURNAL_FAILURE, std::move(err));
+    }
+    journal = std::move(writer);
+    return EngineResponse::Success("Replayed " + std::to_string(replayed) + " journal records");
+}
+
+void TradingEngine::recoverFromJournal(std::vector<JournalRecord> records, size_t threads) {
+    // Serial pass: orders into the registry and books created, both in journal order.
+    // Each symbol goes to one partition (round-robin by first appearance), cancels follow their order.
+    std::vector<std::shared_ptr<Order>> orders(records.size());
+    std::vector<OrderBook*> books(records.size());
+    std::unordered_map<Symbol, size_t> partitionOf;
+    std::unordered_map<OrderID, size_t> recordOf;
+    std::vector<std::vector<size_t>> partitions;
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    OrderID maxId = 0;
+    {
+        std::unique_lock lock(registryMutex);
+        for (size_t i = 0; i < records.size(); ++i) {
+            const JournalRecord& rec = records[i];
+            size_t owner = 0;
+            if (rec.type == JournalRecordType::CANCEL) {
+                auto it = recordOf.find(rec.orderId);
+                if (it == recordOf.end()) continue; // Cannot happen for an intact journal
+                orders[i] = orders[it->second];
+                books[i] = books[it->second];
+                owner = partitionOf.at(orders[i]->symbol);
+            } else {
+                auto order = std::make_shared<Order>(
+                    rec.orderId, rec.timestamp, rec.price, rec.quantity, rec.quantity, 0.0,
+                    rec.side, rec.orderType, OrderStatus::ACTIVE, rec.symbol, rec.tag
+                );
+                order->pegType = rec.pegType;
+                order->displayQuantity = rec.displayQuantity;
+                order->session = rec.session;
+                tagFilter.insert(order->tag);
+                tagToId.emplace(order->tag, order->orderID);
+                idRegistry[order->orderID] = order;
+                recordOf[order->orderID] = i;
+                maxId = std::max(maxId, order->orderID);
+                orders[i] = std::move(order);
+                books[i] = getOrAddBook(rec.symbol);
+
+                auto [it, fresh] = partitionOf.try_emplace(rec.symbol, partitionOf.size() % threads);
+                if (fresh && partitions.size() < threads) partitions.emplace_back();
+                owner = it->second;
+            }
+            partitions[owner].push_back(i);
+        }
+    }
+
+    // Parallel pass: books are independent, so each partition replays its records on its own
+    // thread. Matching touches only the partition's books and orders; everything the serial
+    // path would have pushed into shared state is recorded per record for the merge instead.
+    struct Outcome {
+        size_t fills = 0;
+        std::vector<OrderID> terminal; // In the order queueTerminal / internalCancel push them
+    };
+    std::vector<Outcome> outcomes(records.size());
+    auto replay = [&](const std::vector<size_t>& indices) {
+        std::atomic<ExecID> localExecId{0}; // Real ids are a global sequence, fixed up in the merge
+        for (size_t i : indices) {
+            Order& order = *orders[i];
+            Outcome& out = outcomes[i];
+            if (records[i].type == JournalRecordType::CANCEL) {
+                if (order.isFinished()) continue;
+                if (auto cancelled = books[i]->cancelById(order.orderID)) {
+                    std::unique_lock lock(order.stateMutex);
+                    order.status = OrderStatus::CANCELLED;
+                    order.remainingQuantity = *cancelled;
+                    out.terminal.push_back(order.orderID);
+                }
+                continue;
+            }
+            MatchResult result = books[i]->execute(orders[i], localExecId);
+            out.fills = result.fills.size();
+            for (const auto& fill : result.fills) {
+                if (Precision::isZero(fill.makerRemaining)) out.terminal.push_back(fill.makerOrderId);
+            }
+            if (order.isFinished()) out.terminal.push_back(order.orderID);
+        }
+    };
+    if (partitions.size() <= 1) {
+        for (const auto& indices : partitions) replay(indices);
+    } else {
+        std::vector<std::thread> workers;
+        workers.reserve(partitions.size());
+        for (const auto& indices : partitions) workers.emplace_back(replay, std::cref(indices));
+        for (auto& worker : workers) worker.join();
+    }
+
+    // Merge in journal order: exactly the state serial replay leaves behind
+    ExecID fills = 0;
+    {
+        std::unique_lock lock(registryMutex);
+        for (const Outcome& out : outcomes) {
+            fills += out.fills;
+            terminalOrders.insert(terminalOrders.end(), out.terminal.begin(), out.terminal.end());
+        }
+    }
+    nextExecId.fetch_add(fills, std::memory_order_relaxed);
+    if (Order::globalCounter.load(std::memory_order_relaxed) <= maxId) {
+        Order::globalCounter.store(maxId + 1, std::memory_order_relaxed);
+    }
+}
+
+EngineResponse TradingEngine::commitJournal() {
+    if (!journal) return EngineResponse::Success("No journal");
+    if (std::string err = journal->commit(); !err.empty()) {
+        return EngineResponse::Error(EngineStatusCode::JOURNAL_FAILURE, std::move(err));
+    }
+    return EngineResponse::Success("Committed");
+}
+
+// ============================================================================
+// SECTION 5: SESSION EGRESS
+// ============================================================================
+
+SessionEgress* TradingEngine::openSession(SessionID session) {
+    if (session == 0) return nullptr; // Anonymous orders never get reports
+    std::unique_lock lock(sessionMutex);
+    auto& egress = sessions[session];
+    if (!egress) {
+        egress = std::make_shared<SessionEgress>();
+        openSessions.fetch_add(1, std::memory_order_relaxed);
+    }
+    return egress.get();
+}
+
+void TradingEngine::closeSession(SessionID session) {
+    std::unique_lock lock(sessionMutex);
+    if (sessions.erase(session) > 0) openSessions.fetch_sub(1, std::memory_order_relaxed);
+}
+
+std::shared_ptr<const SessionEgress> TradingEngine::findSession(SessionID session) const {
+    std::shared_lock lock(sessionMutex);
+    auto it = sessions.find(session);
+    return (it == sessions.end()) ? nullptr : it->second;
+}
+
+// ============================================================================
+// SECTION 6: ORDER UPDATE SUBSCRIPTIONS
+// ============================================================================
+
+SubscriptionID TradingEngine::subscribe(const SubscriptionFilter& filter, OrderUpdateCallback callback) {
+    return addSubscription(filter, {0, std::move(callback), nullptr});
+}
+
+SubscriptionID TradingEngine::subscribe(const SubscriptionFilter& filter, OrderUpdateQueue& queue) {
+    return addSubscription(filter, {0, nullptr, &queue});
+}
+
+SubscriptionID TradingEngine::addSubscription(const SubscriptionFilter& filter, Subscription sub) {
+    std::unique_lock lock(subscriptionMutex);
+    sub.id = nextSubscriptionId++;
+    SubscriptionID id = sub.id;
+    if (const auto* session = std::get_if<SessionID>(&filter.scope)) {
+        sessionSubscribers[*session].push_back(std::move(sub));
+    } else if (const auto* symbol = std::get_if<Symbol>(&filter.scope)) {
+        symbolSubscribers[*symbol].push_back(std::move(sub));
+    } else {
+        allSubscribers.push_back(std::move(sub));
+    }
+    subscriberCount.fetch_add(1, std::memory_order_relaxed);
+    return id;
+}
+
+void TradingEngine::unsubscribe(SubscriptionID id) {
+    std::unique_lock lock(subscriptionMutex);
+    auto removeFrom = [&](std::vector<Subscription>& subs) {
+        size_t removed = std::erase_if(subs, [id](const Subscription& s) { return s.id == id; });
+        subscriberCount.fetch_sub(removed, std::memory_order_relaxed);
+        return removed > 0;
+    };
+    if (removeFrom(allSubscribers)) return;
+    for (auto& [session, subs] : sessionSubscribers) if (removeFrom(subs)) return;
+    for (auto& [symbol, subs] : symbolSubscribers) if (removeFrom(subs)) return;
+}
+
+void TradingEngine::notify(const OrderUpdate& update) {
+    std::shared_lock lock(subscriptionMutex);
+    auto deliver = [&update](const std::vector<Subscription>& subs) {
+        for (const auto& sub : subs) {
+            if (sub.queue) sub.queue->publish(update);
+            else sub.callback(update);
+        }
+    };
+    deliver(allSubscribers);
+    if (auto it = sessionSubscribers.find(update.session); it != sessionSubscribers.end()) deliver(it->second);
+    if (auto it = symbolSubscribers.find(update.symbol); it != symbolSubscribers.end()) deliver(it->second);
+}
+
+void TradingEngine::publishUpdates(const MatchResult& result, const Order& taker) {
+    auto fillKind = [](double leaves) {
+        return Precision::isZero(leaves) ? OrderUpdateKind::FILL : OrderUpdateKind::PARTIAL_FILL;
+    };
+    Side makerSide = (taker.side == Side::BUY) ? Side::SELL : Side::BUY;
+
+    notify({OrderUpdateKind::ACK, taker.orderID, taker.session, taker.symbol, taker.side,
+            0, 0.0, 0.0, taker.originalQuantity});
+
+    // Maker first: the resting order changed state before the taker's fill is reported
+    double takerLeaves = taker.originalQuantity;
+    for (const auto& fill : result.fills) {
+        Precision::subtract_or_zero(takerLeaves, fill.quantity);
+        notify({fillKind(fill.makerRemaining), fill.makerOrderId, fill.makerSession, taker.symbol, makerSide,
+                fill.executionId, fill.price, fill.quantity, fill.makerRemaining});
+        notify({fillKind(takerLeaves), taker.orderID, taker.session, taker.symbol, taker.side,
+                fill.executionId, fill.price, fill.quantity, takerLeaves});
+    }
+
+    if (taker.status == OrderStatus::CANCELLED) { // Market remainder with no liquidity left
+        notify({OrderUpdateKind::CANCEL, taker.orderID, taker.session, taker.symbol, taker.side,
+                0, 0.0, 0.0, taker.remainingQuantity});
+    }
+}
+
+// ============================================================================
+// SECTION 7: MARKET DATA
+// ============================================================================
+
+void TradingEngine::enableMarketData() {
+    std::unique_lock lock(bookshelfMutex);
+    marketDataEnabled = true;
+    for (auto& [symbol, book] : symbolBooks) book->enableMarketData();
+}
+
+std::vector<const MarketDataRing*> TradingEngine::getMarketDataRings() const {
+    std::shared_lock lock(bookshelfMutex);
+    std::vector<const MarketDataRing*> rings;
+    rings.reserve(symbolBooks.size());
+    for (const auto& [symbol, book] : symbolBooks) {
+        if (const MarketDataRing* ring = book->getMarketData()) rings.push_back(ring);
+    }
+    return rings;
+}
@@ -0,0 +1,150 @@
+#include "UdpGateway.hpp"
+#include "CommandShell.hpp"
+#include "Endpoint.hpp"
+
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cstring>
+#include <ctime>
+
+namespace {
+    uint64_t realtimeNs() {
+        timespec ts;
+        ::clock_gettime(CLOCK_REALTIME, &ts);
+        return static_cast<uint64_t>(ts.tv_sec) * 1'000'000'000ULL + static_cast<uint64_t>(ts.tv_nsec);
+    }
+
+    std::string formatReply(const std::optional<EngineResponse>& resp) {
+        if (!resp) return "ERR Unknown command";
+        if (!resp->isSuccess()) return "ERR " + std::to_string(static_cast<int>(resp->code)) + " " + resp->message;
+
+        std::string reply = "OK " + resp->message;
+        if (resp->order) {
+            reply += " id=" + std::to_string(resp->order->orderID)
+                   + " rem=" + std::to_string(resp->order->remainingQuantity)
+                   + " fills=" + std::to_string(resp->fills.size());
+        }
+        if (resp->rendered) reply += "\n" + *resp->rendered;
+        return reply;
+    }
+}
+
+UdpGateway::UdpGateway(TradingEngine& engine) : engine(engine) {
+    socketFd = ::socket(AF_INET, SOCK_DGRAM, 0);
+    int on = 1;
+    if (socketFd >= 0) ::setsockopt(socketFd, SOL_SOCKET, SO_TIMESTAMPNS, &on, sizeof(on));
+}
+
+UdpGateway::~UdpGateway() {
+    if (socketFd >= 0) ::close(socketFd);
+}
+
+std::string UdpGateway::bind(std::string_view endpoint) {
+    if (socketFd < 0) return "Cannot open UDP socket";
+    sockaddr_in addr;
+    if (std::string error = parseEndpoint(endpoint, addr, true); !error.empty()) return error;
+    // Peers are told apart by address only, which anyone on a routed network can forge
+    if ((ntohl(addr.sin_addr.s_addr) >> 24) != 127) return "Gateway binds to loopback only";
+    if (::bind(socketFd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0) return "Cannot bind";
+    return {};
+}
+
+SessionID UdpGateway::sessionFor(const sockaddr_in& peer) {
+    uint64_t key = (static_cast<uint64_t>(peer.sin_addr.s_addr) << 16) | peer.sin_port;
+    auto it = peerSessions.find(key);
+    if (it != peerSessions.end()) return it->second;
+    if (peerSessions.size() == Config::GATEWAY_MAX_PEERS) return 0;
+    SessionID session = Config::GATEWAY_FIRST_SESSION + static_cast<SessionID>(peerSessions.size());
+    peerSessions.emplace(key, session);
+    return session;
+}
+
+uint16_t UdpGateway::getPort() const {
+    sockaddr_in addr{};
+    socklen_t len = sizeof(addr);
+    if (::getsockname(socketFd, reinterpret_cast<sockaddr*>(&addr), &len) != 0) return 0;
+    return ntohs(addr.sin_port);
+}
+
+const char* UdpGateway::stageName(GatewayStage stage) {
+    switch (stage) {
+        case GatewayStage::SOCKET_QUEUE:  return "socket_queue";
+        case GatewayStage::DECODE:        return "decode";
+        case GatewayStage::DISPATCH:      return "dispatch";
+        case GatewayStage::REPLY:         return "reply";
+        case GatewayStage::TICK_TO_TRADE: return "tick_to_trade";
+        case GatewayStage::COUNT:         break;
+    }
+    return "unknown";
+}
+
+size_t UdpGateway::drain() {
+    char payload[Config::GATEWAY_MAX_DATAGRAM];
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(timespec))];
+
+    size_t served = 0;
+    while (served < Config::GATEWAY_BATCH) {
+        sockaddr_in peer{};
+        iovec iov{payload, sizeof(payload)};
+        msghdr msg{};
+        msg.msg_name = &peer;
+        msg.msg_namelen = sizeof(peer);
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+
+        ssize_t n = ::recvmsg(socketFd, &msg, MSG_DONTWAIT);
+        if (n < 0) break;
+        uint64_t receivedNs = realtimeNs();
+
+        uint64_t kernelNs = 0;
+        for (cmsghdr* c = CMSG_FIRSTHDR(&msg); c; c = CMSG_NXTHDR(&msg, c)) {
+            if (c->cmsg_level == SOL_SOCKET && c->cmsg_type == SCM_TIMESTAMPNS) {
+                timespec ts;
+                std::memcpy(&ts, CMSG_DATA(c), sizeof(ts));
+                kernelNs = static_cast<uint64_t>(ts.tv_sec) * 1'000'000'000ULL + static_cast<uint64_t>(ts.tv_nsec);
+            }
+        }
+        if (kernelNs == 0) {
+            ++untimestamped;
+            kernelNs = receivedNs;
+        }
+
+        if (msg.msg_flags & MSG_TRUNC) {
+            // The tail of the command is gone: acting on the prefix could trade the wrong size
+            ++truncated;
+            std::string reply = formatReply(EngineResponse::Error(EngineStatusCode::VALIDATION_FAILURE,
+                "Request exceeds " + std::to_string(Config::GATEWAY_MAX_DATAGRAM) + " bytes"));
+            ::sendto(socketFd, reply.data(), reply.size(), 0, reinterpret_cast<const sockaddr*>(&peer), msg.msg_namelen);
+            ++served;
+            continue;
+        }
+
+        std::string_view line(payload, static_cast<size_t>(n));
+        while (!line.empty() && (line.back() == '\n' || line.back() == '\r')) line.remove_suffix(1);
+        std::string_view cmd = get_next_token(line);
+        uint64_t decodedNs = realtimeNs();
+
+        // Anything outside order entry and queries is unknown here, RESET included
+        std::optional<EngineResponse> resp;
+        if (isGatewayCommand(cmd)) {
+            SessionID session = sessionFor(peer);
+            if (session != 0) resp = dispatchCommand(engine, cmd, line, session);
+            else resp = EngineResponse::Error(EngineStatusCode::VALIDATION_FAILURE, "Too many gateway peers");
+        }
+        uint64_t dispatchedNs = realtimeNs();
+
+        std::string reply = formatReply(resp);
+        ::sendto(socketFd, reply.data(), reply.size(), 0, reinterpret_cast<const sockaddr*>(&peer), msg.msg_namelen);
+        uint64_t sentNs = realtimeNs();
+
+        record(GatewayStage::SOCKET_QUEUE, kernelNs, receivedNs);
+        record(GatewayStage::DECODE, receivedNs, decodedNs);
+        record(GatewayStage::DISPATCH, decodedNs, dispatchedNs);
+        record(GatewayStage::REPLY, dispatchedNs, sentNs);
+        record(GatewayStage::TICK_TO_TRADE, kernelNs, sentNs);
+        ++served;
+    }
+    return served;
+}
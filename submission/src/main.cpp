@@ -1,6 +1,7 @@
 #include "main.hpp"
 #include <thread>
 #include <chrono>
+#include <fstream>
 
 // Atomic flag to signal the listener thread to stop on exit
 std::atomic<bool> keepRunning{true};
@@ -48,20 +49,7 @@ void displayOrderReport(const Order& o) {
 }
 
 void displayBook(const OrderBookSnapshot& snap) {
-    std::cout << "\n--- MARKET: " << snap.symbol.c_str() << " (Seq: " << snap.updateSeq << ") ---\n";
-    std::cout << std::setw(10) << "Price" << " | " << std::setw(10) << "Volume" << "\n";
-    std::cout << "---------------------------\n";
-
-    for (auto it = snap.asks.rbegin(); it != snap.asks.rend(); ++it) {
-        std::cout << "\033[1;31m" << std::setw(10) << it->price << "\033[0m | " 
-                  << std::setw(10) << it->quantity << "\n";
-    }
-    std::cout << "  ---------- SPREAD ----------\n";
-    for (const auto& level : snap.bids) {
-        std::cout << "\033[1;32m" << std::setw(10) << level.price << "\033[0m | " 
-                  << std::setw(10) << level.quantity << "\n";
-    }
-    std::cout << "---------------------------\n" << std::endl;
+    std::cout << renderSnapshotText(snap) << std::flush;
 }
 
 void handleResponse(const EngineResponse& resp) {
@@ -69,23 +57,132 @@ void handleResponse(const EngineResponse& resp) {
         std::cout << ">>> SUCCESS: " << resp.message << std::endl;
         if (resp.order) displayOrderReport(*resp.order);
         if (resp.snapshot.has_value()) displayBook(resp.snapshot.value());
+        if (resp.rendered) std::cout << *resp.rendered << std::flush;
+        if (resp.market.has_value()) {
+            std::cout << "=== CONSISTENT CUT @ EPOCH " << resp.market->epoch << " ===" << std::endl;
+            for (const auto& snap : resp.market->books) displayBook(snap);
+        }
     } else {
         std::cout << ">>> ERROR [" << (int)resp.code << "]: " << resp.message << std::endl;
     }
 }
 
-int main() {
+// Serves the UDP gateway and hands quiet periods to background maintenance; returns as soon
+// as shell input is pending. Everything here runs on the matcher thread.
+void idleUntilInput(IdleScheduler& idle, const StdinReader& input, UdpGateway* gateway) {
+    // One gateway batch per shell line even when input never pauses: steady stdin traffic
+    // must not leave datagrams queued, charging the wait to the tick-to-trade histograms
+    if (gateway) gateway->drain();
+
+    auto inputPending = [&input] { return input.pending(); };
+    while (!input.pending()) {
+        if (gateway && gateway->drain() > 0) continue;
+        idle.runIdle(std::chrono::microseconds(Config::IDLE_BURST_US), inputPending);
+        if (!idle.hasPendingWork()) input.waitReadable(Config::IDLE_POLL_MS, gateway ? gateway->getFd() : -1);
+    }
+}
+
+void printGatewayLatency(const UdpGateway& gateway) {
+    for (size_t s = 0; s < static_cast<size_t>(GatewayStage::COUNT); ++s) {
+        auto stage = static_cast<GatewayStage>(s);
+        const LatencyHistogram& h = gateway.getHistogram(stage);
+        std::cerr << std::format("[Gateway] {:<14} n={} p50<={}ns p99<={}ns max={}ns\n", UdpGateway::stageName(stage),
+                                 h.getCount(), h.percentile(0.50), h.percentile(0.99), h.getMax());
+    }
+}
+
+int main(int argc, char* argv[]) {
     TradingEngine engine;
     ThreadSafeQueue<EngineResponse> responseQueue;
+
+    // Optional flags:
+    //   --store <file>   keep every order in a persistent slab and resume from it on restart
+    //   --journal <file> journal accepted orders and cancels compactly and replay them on restart
+    //                    (an alternative to --store: the two cannot be combined)
+    //   --record <file>  log each command with its arrival time for kraken_replay
+    //   --audit <file>   append an audit trail of accepts, fills and cancels (written off-thread)
+    //   --md <ip:port>[,<ip:port>...]  publish L2/trade events over UDP (unicast or multicast)
+    //   --gateway <127.x.y.z:port>  accept order entry over UDP (loopback only; a peer cancels only its
+    //                    own orders), with per-stage tick-to-trade latency
+    std::ofstream recording;
+    std::unique_ptr<AuditLog> auditLog;
+    std::unique_ptr<MarketDataPublisher> marketData;
+    std::unique_ptr<UdpGateway> gateway;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string_view flag(argv[i]);
+        if (flag == "--store") {
+            EngineResponse attached = engine.attachStore(argv[i + 1]);
+            handleResponse(attached);
+            if (!attached.isSuccess()) return 1;
+        } else if (flag == "--journal") {
+            EngineResponse attached = engine.attachJournal(argv[i + 1]);
+            handleResponse(attached);
+            if (!attached.isSuccess()) return 1;
+        } else if (flag == "--audit") {
+            auditLog = std::make_unique<AuditLog>(argv[i + 1]);
+            if (!auditLog->isOpen()) {
+                std::cerr << "Cannot open audit file " << argv[i + 1] << std::endl;
+                return 1;
+            }
+            engine.setAuditLog(auditLog.get());
+            auditLog->start();
+        } else if (flag == "--md") {
+            marketData = std::make_unique<MarketDataPublisher>(engine);
+            std::string_view list(argv[i + 1]);
+            while (!list.empty()) {
+                size_t comma = list.find(',');
+                std::string_view endpoint = list.substr(0, comma);
+                list = (comma == std::string_view::npos) ? std::string_view{} : list.substr(comma + 1);
+                if (std::string error = marketData->addEndpoint(endpoint); !error.empty()) {
+                    std::cerr << "Bad market-data endpoint " << endpoint << ": " << error << std::endl;
+                    return 1;
+                }
+            }
+            engine.enableMarketData();
+            marketData->start();
+        } else if (flag == "--gateway") {
+            gateway = std::make_unique<UdpGateway>(engine);
+            if (std::string error = gateway->bind(argv[i + 1]); !error.empty()) {
+                std::cerr << "Cannot start gateway on " << argv[i + 1] << ": " << error << std::endl;
+                return 1;
+            }
+        } else if (flag == "--record") {
+            recording.open(argv[i + 1]);
+            if (!recording) {
+                std::cerr << "Cannot open recording file " << argv[i + 1] << std::endl;
+                return 1;
+            }
+        }
+    }
+    const auto sessionStart = std::chrono::steady_clock::now();
+
+    // Idle-time maintenance: runs on this (matcher) thread between commands only
+    IdleScheduler idle;
+    idle.addTask("archive", [&engine] {
+        return engine.archiveTerminalOrders(Config::ARCHIVE_BATCH) == Config::ARCHIVE_BATCH;
+    });
+    idle.addTask("warm", [&engine] {
+        engine.warmBooks();
+        return false;
+    });
+    idle.addTask("flush", [&engine, journalFailing = false]() mutable {
+        engine.flushStore();
+        // Report a journal failure once, and again only after it has recovered
+        EngineResponse committed = engine.commitJournal();
+        if (!committed.isSuccess() && !journalFailing) handleResponse(committed);
+        journalFailing = !committed.isSuccess();
+        return false;
+    });
+    StdinReader input;
     
     // Launch background UI thread
     std::thread listener(resultListener, std::ref(responseQueue));
 
     std::string line;
     std::cout << "Kraken Performance Engine [Threaded Shell Ready]\n";
-    std::cout << "Commands: LIMIT, MARKET, CANCEL, BOOK, QUIT\n" << std::endl;
+    std::cout << "Commands: LIMIT, MARKET, ICEBERG, PEG, CANCEL, BOOK, BOOKS, DEPTH, DIGEST, RESET, QUIT\n" << std::endl;
 
-    while (std::cout << "engine> " && std::getline(std::cin, line)) {
+    while (std::cout << "engine> " << std::flush && (idleUntilInput(idle, input, gateway.get()), input.getline(line))) {
         if (line.empty()) continue;
 
         std::string_view sv(line);
@@ -102,45 +199,12 @@ int main() {
             
             break;
         }
-        else if (cmd == "ECHO") {
-            EngineResponse resp;
-            resp.code = EngineStatusCode::OK;
-            resp.message = std::string(sv);
-            responseQueue.push(resp);
-        }
-        else if (cmd == "LIMIT") {
-            std::string_view s_side = get_next_token(sv);
-            std::string_view sym_name = get_next_token(sv);
-            double qty = to_double(get_next_token(sv));
-            double price = to_double(get_next_token(sv));
-            std::string_view tag = get_next_token(sv);
-
-            Side side = (s_side == "BUY") ? Side::BUY : Side::SELL;
-            responseQueue.push(engine.submitOrder(LimitOrderRequest{
-                price, qty, side, Symbol{sym_name}, std::string(tag)
-            }));
-        } 
-        else if (cmd == "MARKET") {
-            std::string_view s_side = get_next_token(sv);
-            std::string_view sym_name = get_next_token(sv);
-            double qty = to_double(get_next_token(sv));
-            std::string_view tag = get_next_token(sv);
-
-            Side side = (s_side == "BUY") ? Side::BUY : Side::SELL;
-            responseQueue.push(engine.submitOrder(MarketOrderRequest{
-                qty, side, Symbol{sym_name}, std::string(tag)
-            }));
-        } 
-        else if (cmd == "CANCEL") {
-            OrderID id = to_num<OrderID>(get_next_token(sv));
-            responseQueue.push(engine.cancelOrder(id));
-        } 
-        else if (cmd == "BOOK") {
-            std::string_view sym_name = get_next_token(sv);
-            int depth = to_num<int>(get_next_token(sv));
-            if (depth == 0) depth = 5;
-            responseQueue.push(engine.getOrderBookSnapshot(Symbol{sym_name}, depth));
+
+        if (recording.is_open()) {
+            auto sinceStart = std::chrono::steady_clock::now() - sessionStart;
+            recording << std::chrono::duration_cast<std::chrono::nanoseconds>(sinceStart).count() << ' ' << line << '\n';
         }
+        if (auto resp = dispatchCommand(engine, cmd, sv)) responseQueue.push(std::move(*resp));
     }
 
     while (!responseQueue.empty()) {
@@ -149,6 +213,13 @@ int main() {
     keepRunning = false;
     if (listener.joinable()) listener.join();
 
+    if (marketData) marketData->stop();
+    if (gateway) printGatewayLatency(*gateway);
+    if (auditLog) {
+        auditLog->stop();
+        if (auditLog->getDropped() > 0) std::cerr << "[Audit] Dropped " << auditLog->getDropped() << " events" << std::endl;
+    }
+
     std::cout << "\n[System] Shutdown complete." << std::endl;
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,111 @@
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BenchReport.hpp"
+#include "CommandShell.hpp"
+
+// kraken_replay: paced replay of a session captured with `kraken_submission --record <file>`.
+//
+//   kraken_replay <recording> [--speed X]
+//
+// Each line is "<ns since session start> <command>". Every message is sent at its recorded
+// offset divided by X (1 = real time, 10 = ten times faster, 0 = back to back), and its latency
+// is measured from that intended send time, so time spent queued behind a slow message counts.
+// The kraken-bench/1 report goes to $BENCH_REPORT, or stdout if unset; a summary goes to stderr.
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    struct Message {
+        int64_t offsetNs;
+        std::string line;
+    };
+
+    // Sleeps through long gaps, then spins the final stretch so the send time is exact
+    void waitUntil(Clock::time_point target) {
+        constexpr auto spinWindow = std::chrono::milliseconds(1); // Covers typical sleep overshoot
+        auto now = Clock::now();
+        if (target - now > spinWindow) std::this_thread::sleep_for(target - now - spinWindow);
+        while (Clock::now() < target) {
+#if defined(__x86_64__) || defined(__i386__)
+            __builtin_ia32_pause();
+#endif
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: kraken_replay <recording> [--speed X]" << std::endl;
+        return 2;
+    }
+    std::string_view speedArg = "1";
+    for (int i = 2; i + 1 < argc; i += 2) {
+        if (std::string_view(argv[i]) == "--speed") speedArg = argv[i + 1];
+    }
+    const double speed = to_double(speedArg);
+
+    // Load everything first: no file I/O inside the paced loop
+    std::ifstream in(argv[1]);
+    if (!in) {
+        std::cerr << "Cannot open " << argv[1] << std::endl;
+        return 2;
+    }
+    std::vector<Message> messages;
+    for (std::string raw; std::getline(in, raw);) {
+        std::string_view sv(raw);
+        std::string_view stamp = get_next_token(sv);
+        if (stamp.empty() || stamp[0] == '#') continue;
+        messages.push_back({to_num<int64_t>(stamp), std::string(sv)});
+    }
+    if (messages.empty()) {
+        std::cerr << "No messages in " << argv[1] << std::endl;
+        return 2;
+    }
+
+    TradingEngine engine;
+    std::vector<double> latency, service, sendLag;
+    latency.reserve(messages.size());
+    service.reserve(messages.size());
+    sendLag.reserve(messages.size());
+
+    const int64_t firstOffset = messages.front().offsetNs;
+    const auto start = Clock::now();
+    for (const auto& msg : messages) {
+        auto scheduled = start;
+        if (speed > 0.0) {
+            scheduled += std::chrono::nanoseconds(static_cast<int64_t>((msg.offsetNs - firstOffset) / speed));
+            waitUntil(scheduled);
+        }
+
+        auto sent = Clock::now();
+        std::string_view sv(msg.line);
+        std::string_view cmd = get_next_token(sv);
+        dispatchCommand(engine, cmd, sv);
+        auto done = Clock::now();
+
+        if (speed <= 0.0) scheduled = sent;
+        latency.push_back(std::chrono::duration<double, std::nano>(done - scheduled).count());
+        service.push_back(std::chrono::duration<double, std::nano>(done - sent).count());
+        sendLag.push_back(std::chrono::duration<double, std::nano>(sent - scheduled).count());
+    }
+    double elapsedSec = std::chrono::duration<double>(Clock::now() - start).count();
+
+    BenchReport report("kraken_replay@" + std::string(speedArg) + "x"); // Runs at different speeds never pool
+    report.addScalar("replay_throughput", "msg/s", BenchReport::Better::HIGHER, messages.size() / elapsedSec);
+    report.addDistribution("replay_latency_vs_schedule", "ns", BenchReport::Better::LOWER, latency);
+    report.addDistribution("replay_service_time", "ns", BenchReport::Better::LOWER, service);
+    report.addDistribution("replay_send_lag", "ns", BenchReport::Better::LOWER, sendLag);
+
+    std::cerr << "Replayed " << messages.size() << " messages in " << elapsedSec << " s at " << speed
+              << "x | latency p50 " << latency[latency.size() / 2] << " ns, p99 "
+              << latency[std::min(latency.size() - 1, latency.size() * 99 / 100)] << " ns" << std::endl;
+
+    if (std::getenv("BENCH_REPORT")) return report.writeIfRequested() ? 0 : 1;
+    std::cout << report.toJson();
+    return 0;
+}
@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <sstream>
+#include <thread>
+#include "TradingEngine.hpp"
+
+class AuditLogSuite : public ::testing::Test {
+protected:
+    const Symbol sym{"BTC/USD"};
+    std::string path;
+
+    void SetUp() override {
+        path = (std::filesystem::temp_directory_path() /
+                ("audit_" + std::to_string(::getpid()) + ".log")).string();
+        std::filesystem::remove(path);
+    }
+    void TearDown() override { std::filesystem::remove(path); }
+
+    std::vector<std::string> readLines() const {
+        std::ifstream in(path);
+        std::vector<std::string> lines;
+        for (std::string line; std::getline(in, line);) lines.push_back(line);
+        return lines;
+    }
+};
+
+TEST_F(AuditLogSuite, RingDeliversEveryEventFromConcurrentProducers) {
+    MpscRing<uint64_t, 1024> ring;
+    constexpr uint64_t perProducer = 20000;
+    constexpr int producers = 4;
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&ring, p] {
+            for (uint64_t i = 0; i < perProducer; ++i) {
+                while (!ring.tryPush(p * perProducer + i)) std::this_thread::yield();
+            }
+        });
+    }
+
+    // Per-producer FIFO must hold even though producers interleave
+    std::vector<uint64_t> next(producers, 0);
+    uint64_t received = 0, value = 0;
+    while (received < perProducer * producers) {
+        if (!ring.tryPop(value)) continue;
+        int p = static_cast<int>(value / perProducer);
+        ASSERT_EQ(value % perProducer, next[p]++);
+        ++received;
+    }
+    for (auto& t : threads) t.join();
+    EXPECT_FALSE(ring.tryPop(value));
+}
+
+TEST_F(AuditLogSuite, EngineEventsReachTheFile) {
+    {
+        AuditLog log(path);
+        ASSERT_TRUE(log.isOpen());
+        TradingEngine engine;
+        engine.setAuditLog(&log);
+        log.start();
+
+        engine.submitOrder(LimitOrderRequest{100.0, 1.0, Side::SELL, sym, "M"});
+        engine.submitOrder(LimitOrderRequest{100.0, 3.0, Side::BUY, sym, "T"});
+        engine.cancelOrderByTag("T");
+        engine.submitOrder(MarketOrderRequest{1.0, Side::BUY, sym, "MKT"});
+        log.stop();
+        EXPECT_EQ(log.getWritten(), 6u);
+        EXPECT_EQ(log.getDropped(), 0u);
+    }
+
+    auto lines = readLines();
+    ASSERT_EQ(lines.size(), 6u);
+    std::vector<std::string> kinds;
+    for (const auto& line : lines) {
+        std::istringstream fields(line);
+        std::string ts, kind;
+        fields >> ts >> kind;
+        kinds.push_back(kind);
+    }
+    EXPECT_EQ(kinds, (std::vector<std::string>{"ACCEPT", "ACCEPT", "FILL", "CANCEL", "ACCEPT", "EXPIRE"}));
+}
+
+TEST_F(AuditLogSuite, FullRingDropsInsteadOfBlockingAndReportsIt) {
+    AuditLog log(path);
+    AuditEvent event{AuditLog::now(), AuditKind::ACCEPT, Side::BUY, sym, 1, 0, 0, 100.0, 1.0};
+
+    // No logger running yet: the ring fills up and every further event is a counted drop
+    size_t accepted = 0;
+    for (size_t i = 0; i < Config::AUDIT_RING_CAPACITY + 10; ++i) accepted += log.record(event);
+    EXPECT_EQ(accepted, Config::AUDIT_RING_CAPACITY);
+    EXPECT_EQ(log.getDropped(), 10u);
+
+    log.start();
+    log.stop();
+    auto lines = readLines();
+    ASSERT_EQ(lines.size(), Config::AUDIT_RING_CAPACITY + 1);
+    // Reported with the first batch written after the drops happened
+    auto isDropNotice = [](const std::string& line) { return line.find(" DROPPED 10") != std::string::npos; };
+    EXPECT_EQ(std::ranges::count_if(lines, isDropNotice), 1);
+}
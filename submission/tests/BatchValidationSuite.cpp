@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include "TradingEngine.hpp"
+
+class BatchValidationSuite : public ::testing::Test {
+protected:
+    const Symbol sym{"BTC/USD"};
+};
+
+TEST_F(BatchValidationSuite, KernelFlagsEachCheckAndPacksTheMask) {
+    ValidationBatch batch;
+    batch.resize(70); // Spans two mask words
+    for (size_t i = 0; i < batch.size(); ++i) {
+        batch.quantity[i] = 1.0;
+        batch.price[i] = 100.0;
+        batch.bandLow[i] = 50.0;
+        batch.bandHigh[i] = 150.0;
+        batch.tagLength[i] = 4;
+    }
+    batch.quantity[1] = 0.0;
+    batch.tagLength[2] = Config::MAX_TAG_SIZE + 1;
+    batch.symbolEmpty[3] = 1;
+    batch.price[4] = 0.0;
+    batch.fragmented[5] = 1;
+    batch.price[6] = 151.0;
+    batch.quantity[65] = -1.0;
+    batch.price[65] = 1e12; // Both fail: the quantity check comes first
+
+    EXPECT_EQ(validateBatch(batch), 7u);
+    EXPECT_EQ(batch.reason[0], BatchReject::NONE);
+    EXPECT_EQ(batch.reason[1], BatchReject::QUANTITY);
+    EXPECT_EQ(batch.reason[2], BatchReject::TAG);
+    EXPECT_EQ(batch.reason[3], BatchReject::SYMBOL);
+    EXPECT_EQ(batch.reason[4], BatchReject::PRICE_RANGE);
+    EXPECT_EQ(batch.reason[5], BatchReject::FRAGMENTED);
+    EXPECT_EQ(batch.reason[6], BatchReject::PRICE_BAND);
+    EXPECT_EQ(batch.reason[65], BatchReject::QUANTITY);
+    EXPECT_EQ(batch.rejectMask[0], 0b1111110u);
+    EXPECT_EQ(batch.rejectMask[1], 0b10u);
+    EXPECT_TRUE(batch.isRejected(65));
+    EXPECT_FALSE(batch.isRejected(69));
+}
+
+TEST_F(BatchValidationSuite, BatchAnswersLikeOneByOneSubmission) {
+    auto prime = [&](TradingEngine& engine) { // Sets a last price of 100 for the band
+        engine.submitOrder(LimitOrderRequest{100.0, 1.0, Side::SELL, sym, "P1"});
+        engine.submitOrder(LimitOrderRequest{100.0, 1.0, Side::BUY, sym, "P2"});
+    };
+    std::vector<LimitOrderRequest> batch{
+        {101.0, 2.0, Side::SELL, sym, "OK1"},
+        {99.0, 0.0, Side::BUY, sym, "ZERO"},
+        {99.0, 1.0, Side::BUY, sym, std::string(Config::MAX_TAG_SIZE + 1, 'x')},
+        {250.0, 1.0, Side::SELL, sym, "BAND"},
+        {-1.0, 1.0, Side::BUY, sym, "NEG"},
+        {99.0, 1.0, Side::BUY, Symbol(), "NOSYM"},
+        {101.0, 1.5, Side::BUY, sym, "OK2"}, // Trades against OK1
+        {99.0, 1.0, Side::BUY, sym, "OK1"},  // Duplicate tag: caught at registration
+    };
+
+    TradingEngine batched, single;
+    prime(batched);
+    prime(single);
+    auto responses = batched.submitBatch(batch);
+    ASSERT_EQ(responses.size(), batch.size());
+    for (size_t i = 0; i < batch.size(); ++i) {
+        auto expected = single.submitOrder(batch[i]);
+        EXPECT_EQ(responses[i].code, expected.code) << i;
+        EXPECT_EQ(responses[i].message, expected.message) << i;
+        EXPECT_EQ(responses[i].fills.size(), expected.fills.size()) << i;
+    }
+    EXPECT_EQ(batched.getOrderBookSnapshot(sym, 5).snapshot->asks[0].quantity, 0.5);
+}
+
+TEST_F(BatchValidationSuite, SurvivorsAcrossMaskWordsKeepInputOrder) {
+    std::vector<LimitOrderRequest> batch;
+    for (int i = 0; i < 150; ++i) {
+        double qty = (i % 7 == 3) ? 0.0 : 1.0; // Rejects scattered over all three mask words
+        batch.push_back({100.0 + i, qty, Side::SELL, sym, "S" + std::to_string(i)});
+    }
+    TradingEngine batched, single;
+    auto responses = batched.submitBatch(batch);
+    ASSERT_EQ(responses.size(), batch.size());
+    OrderID lastId = 0;
+    for (size_t i = 0; i < batch.size(); ++i) {
+        auto expected = single.submitOrder(batch[i]);
+        ASSERT_EQ(responses[i].code, expected.code) << i;
+        EXPECT_EQ(responses[i].message, expected.message) << i;
+        if (responses[i].order) {
+            EXPECT_GT(responses[i].order->orderID, lastId) << i;
+            lastId = responses[i].order->orderID;
+        }
+    }
+
+    // Nothing survives: every row answered, and no book is created
+    TradingEngine engine;
+    auto none = engine.submitBatch({{0.0, 1.0, Side::BUY, sym, "A"}, {100.0, -1.0, Side::BUY, sym, "B"}});
+    ASSERT_EQ(none.size(), 2u);
+    EXPECT_EQ(none[0].message, "Price out of range");
+    EXPECT_EQ(none[1].message, "Invalid quantity");
+    EXPECT_FALSE(engine.getOrderBookSnapshot(sym, 5).isSuccess());
+}
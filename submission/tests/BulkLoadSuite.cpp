@@ -0,0 +1,270 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include "TradingEngine.hpp"
+
+class BulkLoadSuite : public ::testing::Test {
+protected:
+    const Symbol sym{"BTC/USD"};
+
+    static std::vector<LimitOrderRequest> openingOrders(const Symbol& sym, size_t count, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::vector<LimitOrderRequest> orders;
+        for (size_t i = 0; i < count; ++i) {
+            bool buy = rng() % 2;
+            double px = buy ? 99.0 - (rng() % 200) * 0.01 : 101.0 + (rng() % 200) * 0.01;
+            orders.push_back({px, 1.0 + static_cast<double>(rng() % 5), buy ? Side::BUY : Side::SELL, sym,
+                              "O" + std::to_string(i)});
+        }
+        return orders;
+    }
+
+    // Tags of the makers hit by a full sweep of one side, in fill order
+    static std::vector<std::string> sweep(TradingEngine& engine, const Symbol& sym, Side side, double qty) {
+        auto resp = engine.submitOrder(MarketOrderRequest{qty, side, sym, "SWEEP"});
+        std::vector<std::string> makers;
+        for (const auto& fill : resp.fills) makers.push_back(engine.getOrder(fill.makerOrderId).order->tag);
+        return makers;
+    }
+};
+
+TEST_F(BulkLoadSuite, SeedMatchesOneByOneSubmission) {
+    auto orders = openingOrders(sym, 2000, 7);
+    TradingEngine seeded, submitted;
+    auto resp = seeded.seedBook(sym, orders);
+    ASSERT_TRUE(resp.isSuccess()) << resp.message;
+    for (const auto& req : orders) ASSERT_TRUE(submitted.submitOrder(req).isSuccess());
+
+    auto a = seeded.getOrderBookSnapshot(sym, 1000).snapshot.value();
+    auto b = submitted.getOrderBookSnapshot(sym, 1000).snapshot.value();
+    ASSERT_EQ(a.bids.size(), b.bids.size());
+    ASSERT_EQ(a.asks.size(), b.asks.size());
+    for (size_t i = 0; i < a.bids.size(); ++i) {
+        EXPECT_DOUBLE_EQ(a.bids[i].price, b.bids[i].price);
+        EXPECT_DOUBLE_EQ(a.bids[i].quantity, b.bids[i].quantity);
+    }
+    for (size_t i = 0; i < a.asks.size(); ++i) {
+        EXPECT_DOUBLE_EQ(a.asks[i].price, b.asks[i].price);
+        EXPECT_DOUBLE_EQ(a.asks[i].quantity, b.asks[i].quantity);
+    }
+
+    // Same queues: sweeping either book hits the same makers in the same order
+    EXPECT_EQ(sweep(seeded, sym, Side::BUY, 1e6), sweep(submitted, sym, Side::BUY, 1e6));
+    EXPECT_EQ(sweep(seeded, sym, Side::SELL, 1e6), sweep(submitted, sym, Side::SELL, 1e6));
+}
+
+TEST_F(BulkLoadSuite, SeedIsAllOrNothing) {
+    TradingEngine engine;
+    std::vector<LimitOrderRequest> crossing{{100.0, 1.0, Side::BUY, sym, "B"}, {100.0, 1.0, Side::SELL, sym, "S"}};
+    EXPECT_EQ(engine.seedBook(sym, crossing).code, EngineStatusCode::VALIDATION_FAILURE);
+
+    std::vector<LimitOrderRequest> duplicate{{99.0, 1.0, Side::BUY, sym, "D"}, {98.0, 1.0, Side::BUY, sym, "D"}};
+    EXPECT_EQ(engine.seedBook(sym, duplicate).code, EngineStatusCode::DUPLICATE_TAG);
+    EXPECT_FALSE(engine.getOrderByTag("D").isSuccess());
+    EXPECT_FALSE(engine.getOrderByTag("B").isSuccess());
+
+    ASSERT_TRUE(engine.submitOrder(LimitOrderRequest{99.0, 1.0, Side::BUY, sym, "LIVE"}).isSuccess());
+    std::vector<LimitOrderRequest> late{{98.0, 1.0, Side::BUY, sym, "LATE"}};
+    EXPECT_EQ(engine.seedBook(sym, late).code, EngineStatusCode::VALIDATION_FAILURE);
+}
+
+TEST_F(BulkLoadSuite, SeedWithinEpsilonOfCrossingIsRejected) {
+    // Submitted one by one these two trade, so resting them both would diverge from replay
+    const double ask = 100.0 + Precision::EPSILON / 2;
+    TradingEngine submitted;
+    submitted.submitOrder(LimitOrderRequest{100.0, 1.0, Side::BUY, sym, "B"});
+    ASSERT_EQ(submitted.submitOrder(LimitOrderRequest{ask, 1.0, Side::SELL, sym, "S"}).fills.size(), 1u);
+
+    TradingEngine engine;
+    std::vector<LimitOrderRequest> touching{{100.0, 1.0, Side::BUY, sym, "B"}, {ask, 1.0, Side::SELL, sym, "S"}};
+    auto resp = engine.seedBook(sym, touching);
+    EXPECT_EQ(resp.code, EngineStatusCode::VALIDATION_FAILURE);
+    EXPECT_EQ(resp.message, "Seed orders cross");
+    EXPECT_FALSE(engine.getOrderByTag("B").isSuccess());
+}
+
+TEST_F(BulkLoadSuite, SeedIsHeldToTheFragmentationLimit) {
+    std::vector<LimitOrderRequest> levels;
+    for (int i = 0; i < Config::MAX_PRICE_LEVELS; ++i) {
+        levels.push_back({1000.0 + i * 0.01, 1.0, Side::SELL, sym, "L" + std::to_string(i)});
+    }
+    std::vector<LimitOrderRequest> tooMany = levels;
+    tooMany.push_back({999.0, 1.0, Side::BUY, sym, "ONE_MORE"});
+
+    TradingEngine engine;
+    auto refused = engine.seedBook(sym, tooMany);
+    EXPECT_EQ(refused.code, EngineStatusCode::VALIDATION_FAILURE);
+    EXPECT_EQ(refused.message, "Orderbook too fragmented");
+    ASSERT_TRUE(engine.seedBook(sym, levels).isSuccess());
+    EXPECT_EQ(engine.submitOrder(LimitOrderRequest{999.0, 1.0, Side::BUY, sym, "ONE_MORE"}).message, "Orderbook too fragmented");
+}
+
+TEST_F(BulkLoadSuite, SeededOrdersAreAuditedAndAcknowledged) {
+    const std::string auditPath = (std::filesystem::temp_directory_path() /
+                                   ("seed_audit_" + std::to_string(::getpid()) + ".log")).string();
+    std::vector<OrderID> acked;
+    {
+        AuditLog log(auditPath);
+        ASSERT_TRUE(log.isOpen());
+        TradingEngine engine;
+        engine.setAuditLog(&log);
+        log.start();
+        engine.subscribe(SubscriptionFilter::forSession(4), [&](const OrderUpdate& update) {
+            if (update.kind == OrderUpdateKind::ACK) acked.push_back(update.orderId);
+        });
+
+        auto orders = openingOrders(sym, 10, 3);
+        for (auto& req : orders) req.session = 4;
+        ASSERT_TRUE(engine.seedBook(sym, orders).isSuccess());
+        log.stop();
+        EXPECT_EQ(log.getWritten(), orders.size());
+        ASSERT_EQ(acked.size(), orders.size());
+        EXPECT_EQ(acked.front(), engine.getOrderByTag("O0").order->orderID);
+    }
+    std::ifstream in(auditPath);
+    std::string ts, kind;
+    in >> ts >> kind;
+    EXPECT_EQ(kind, "ACCEPT");
+    std::filesystem::remove(auditPath);
+}
+
+TEST_F(BulkLoadSuite, LoadKeepsTimePriorityAcrossEpsilonEqualPrices) {
+    std::atomic<SeqNum> epoch{0};
+    OrderBook book(sym, epoch);
+    auto resting = [&](double px, SeqNum priority, const char* tag) {
+        auto order = std::make_shared<Order>(px, 1.0, 1.0, 0.0, Side::SELL, OrderType::LIMIT,
+                                             OrderStatus::ACTIVE, sym, tag);
+        return RestingEntry{order, {1.0, 0.0, priority}};
+    };
+    // 100.0 and 100.0 + 1e-12 are one level; the later raw price holds the older priority
+    auto third = resting(100.0, 5, "THIRD"), first = resting(100.0 + 1e-12, 1, "FIRST");
+    auto second = resting(100.0, 3, "SECOND"), far = resting(100.5, 0, "FAR");
+    book.bulkLoad({third, first, second, far});
+    ASSERT_EQ(book.getPriceLevelCount(), 2u);
+
+    std::atomic<ExecID> exec{1};
+    auto taker = std::make_shared<Order>(100.0, 3.0, 3.0, 0.0, Side::BUY, OrderType::LIMIT,
+                                         OrderStatus::ACTIVE, sym, "T");
+    auto result = book.execute(taker, exec);
+    ASSERT_EQ(result.fills.size(), 3u);
+    EXPECT_EQ(result.fills[0].makerOrderId, first.order->orderID);
+    EXPECT_EQ(result.fills[1].makerOrderId, second.order->orderID);
+    EXPECT_EQ(result.fills[2].makerOrderId, third.order->orderID);
+
+    // Loading into a non-empty book goes level by level and keeps the same guarantees
+    book.bulkLoad({resting(100.5, 9, "LATER"), resting(100.25, 8, "MIDDLE")});
+    EXPECT_EQ(book.getPriceLevelCount(), 2u);
+    EXPECT_EQ(book.getOrderCount(), 3u);
+}
+
+TEST_F(BulkLoadSuite, EpsilonChainedPricesPastTheReservedLadderStayIntact) {
+    // Steps of 0.9 epsilon: each price equals its neighbour but not the level's first price,
+    // so the chain builds one level per two entries, more than the ladder reserves up front
+    std::atomic<SeqNum> epoch{0};
+    OrderBook book(sym, epoch);
+    const size_t count = Config::MAX_PRICE_LEVELS + 2000;
+    std::vector<RestingEntry> entries;
+    for (size_t i = 0; i < count; ++i) {
+        double px = 100.0 + static_cast<double>(i) * 0.9 * Precision::EPSILON;
+        auto order = std::make_shared<Order>(px, 1.0, 1.0, 0.0, Side::SELL, OrderType::LIMIT,
+                                             OrderStatus::ACTIVE, sym, "C" + std::to_string(i));
+        // Younger first within every level, so each level has to be sorted afterwards
+        entries.push_back({order, {1.0, 0.0, static_cast<SeqNum>(count - i)}});
+    }
+    book.bulkLoad(entries);
+    ASSERT_EQ(book.getPriceLevelCount(), count / 2);
+
+    std::atomic<ExecID> exec{1};
+    auto taker = std::make_shared<Order>(101.0, 4.0, 4.0, 0.0, Side::BUY, OrderType::LIMIT,
+                                         OrderStatus::ACTIVE, sym, "T");
+    auto result = book.execute(taker, exec);
+    ASSERT_EQ(result.fills.size(), 4u);
+    EXPECT_EQ(result.fills[0].makerOrderId, entries[1].order->orderID);
+    EXPECT_EQ(result.fills[1].makerOrderId, entries[0].order->orderID);
+    EXPECT_EQ(result.fills[2].makerOrderId, entries[3].order->orderID);
+}
+
+TEST_F(BulkLoadSuite, LargeSeedPublishesOnceWithAConsistentIndex) {
+    constexpr size_t count = 100'000;
+    std::vector<LimitOrderRequest> orders;
+    orders.reserve(count);
+    std::mt19937 rng(3);
+    for (size_t i = 0; i < count; ++i) {
+        bool buy = i % 2;
+        double px = buy ? 5000.0 - (rng() % 5000) * 0.5 : 5001.0 + (rng() % 5000) * 0.5;
+        orders.push_back({px, 1.0, buy ? Side::BUY : Side::SELL, sym, "M" + std::to_string(i)});
+    }
+
+    TradingEngine engine;
+    auto resp = engine.seedBook(sym, orders);
+    ASSERT_TRUE(resp.isSuccess()) << resp.message;
+    EXPECT_EQ(resp.digest->sequence, 1u); // One shadow publish for the whole load
+    auto snap = engine.getOrderBookSnapshot(sym, 10).snapshot.value();
+    EXPECT_EQ(snap.bids[0].price, 5000.0);
+    EXPECT_EQ(snap.asks[0].price, 5001.0);
+
+    // Every id resolves to its own entry: cancelling reports that order's quantity and level
+    for (size_t i = 0; i < count; i += 97) {
+        auto order = engine.getOrderByTag(orders[i].tag).order;
+        ASSERT_TRUE(engine.cancelOrder(order->orderID).isSuccess()) << i;
+        EXPECT_EQ(order->status, OrderStatus::CANCELLED);
+        EXPECT_DOUBLE_EQ(order->price, orders[i].price);
+    }
+}
+
+TEST_F(BulkLoadSuite, LoadIntoNonEmptyBookIndexesEveryEntryThenCancels) {
+    std::atomic<SeqNum> epoch{0};
+    OrderBook book(sym, epoch);
+    auto resting = [&](double px, SeqNum priority, const char* tag) {
+        auto order = std::make_shared<Order>(px, 1.0, 1.0, 0.0, Side::SELL, OrderType::LIMIT,
+                                             OrderStatus::ACTIVE, sym, tag);
+        return RestingEntry{order, {1.0, 0.0, priority}};
+    };
+    auto live = resting(100.0, 10, "LIVE");
+    book.bulkLoad({live});
+
+    // Older priorities than the resting order, and a tie with it
+    auto a = resting(100.0, 2, "A"), b = resting(100.0, 1, "B");
+    auto c = resting(100.0, 10, "C"), d = resting(100.5, 4, "D");
+    book.bulkLoad({a, b, c, d});
+    ASSERT_EQ(book.getOrderCount(), 5u);
+    for (const auto* e : {&live, &a, &b, &c, &d}) {
+        ASSERT_EQ(book.getRestingState(e->order->orderID)->priority, e->state.priority);
+    }
+
+    // Cancelling must remove exactly the named entry
+    ASSERT_TRUE(book.cancelById(a.order->orderID).has_value());
+    EXPECT_FALSE(book.getRemainingQty(a.order->orderID).has_value());
+    EXPECT_TRUE(book.getRemainingQty(b.order->orderID).has_value());
+    EXPECT_TRUE(book.getRemainingQty(c.order->orderID).has_value());
+
+    std::atomic<ExecID> exec{1};
+    auto taker = std::make_shared<Order>(100.0, 3.0, 3.0, 0.0, Side::BUY, OrderType::LIMIT,
+                                         OrderStatus::ACTIVE, sym, "T");
+    auto result = book.execute(taker, exec);
+    ASSERT_EQ(result.fills.size(), 3u);
+    EXPECT_EQ(result.fills[0].makerOrderId, b.order->orderID);
+    EXPECT_EQ(result.fills[1].makerOrderId, live.order->orderID); // Tie: already resting goes first
+    EXPECT_EQ(result.fills[2].makerOrderId, c.order->orderID);
+    EXPECT_EQ(book.getOrderCount(), 1u);
+}
+
+TEST_F(BulkLoadSuite, SeedLargerThanTheFreeStoreIsRejectedUpFront) {
+    std::string path = (std::filesystem::temp_directory_path() /
+                        ("bulk_seed_" + std::to_string(::getpid()) + ".slab")).string();
+    std::filesystem::remove(path);
+    {
+        TradingEngine engine;
+        ASSERT_TRUE(engine.attachStore(path, 4).isSuccess());
+        ASSERT_TRUE(engine.submitOrder(LimitOrderRequest{90.0, 1.0, Side::BUY, Symbol("ETH/USD"), "E"}).isSuccess());
+        std::vector<LimitOrderRequest> seed;
+        for (int i = 0; i < 4; ++i) seed.push_back({99.0 - i, 1.0, Side::BUY, sym, "S" + std::to_string(i)});
+        EXPECT_EQ(engine.seedBook(sym, seed).code, EngineStatusCode::VALIDATION_FAILURE);
+        EXPECT_FALSE(engine.getOrderByTag("S0").isSuccess());
+        seed.pop_back();
+        EXPECT_TRUE(engine.seedBook(sym, seed).isSuccess());
+    }
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,42 @@
+#include <gtest/gtest.h>
+#include "CommandShell.hpp"
+
+class CommandShellSuite : public ::testing::Test {
+protected:
+    TradingEngine engine;
+
+    std::optional<EngineResponse> run(std::string_view line) {
+        std::string_view cmd = get_next_token(line);
+        return dispatchCommand(engine, cmd, line);
+    }
+};
+
+TEST_F(CommandShellSuite, ParsesOrderCommandsLikeTheShell) {
+    auto limit = run("LIMIT SELL BTC/USD 2 100 S1");
+    ASSERT_TRUE(limit.has_value());
+    ASSERT_TRUE(limit->isSuccess());
+    EXPECT_EQ(limit->order->side, Side::SELL);
+    EXPECT_DOUBLE_EQ(limit->order->price, 100.0);
+    EXPECT_EQ(limit->order->tag, "S1");
+
+    auto market = run("MARKET BUY BTC/USD 0.5 M1");
+    ASSERT_TRUE(market.has_value());
+    EXPECT_EQ(market->fills.size(), 1u);
+
+    auto book = run("BOOK BTC/USD");
+    ASSERT_TRUE(book.has_value() && book->rendered);
+    EXPECT_NE(book->rendered->find("       100\033[0m |        1.5\n"), std::string::npos);
+    EXPECT_EQ(book->rendered->find("Digest"), std::string::npos);
+
+    // The digest has its own command, matching the one on the last mutating response
+    auto digest = run("DIGEST BTC/USD");
+    ASSERT_TRUE(digest.has_value() && digest->digest.has_value());
+    EXPECT_EQ(digest->digest->digest, market->digest->digest);
+    EXPECT_EQ(run("DIGEST ETH/USD")->code, EngineStatusCode::SYMBOL_NOT_FOUND);
+}
+
+TEST_F(CommandShellSuite, UnknownAndSessionCommandsAreLeftToTheCaller) {
+    EXPECT_FALSE(run("FROBNICATE 1 2 3").has_value());
+    EXPECT_FALSE(run("QUIT").has_value());
+    EXPECT_EQ(run("ECHO hello world")->message, " hello world");
+}
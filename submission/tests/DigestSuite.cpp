@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+#include "TradingEngine.hpp"
+
+class DigestSuite : public ::testing::Test {
+protected:
+    TradingEngine engine;
+    const Symbol sym{"BTC/USD"};
+};
+
+TEST_F(DigestSuite, EveryMutationCarriesSequenceAndDigest) {
+    auto res = engine.submitOrder(LimitOrderRequest{100.0, 1.0, Side::BUY, sym, "A"});
+    ASSERT_TRUE(res.digest.has_value());
+    EXPECT_NE(res.digest->digest, 0u);
+
+    auto snap = engine.getOrderBookSnapshot(sym, 5).snapshot.value();
+    EXPECT_EQ(snap.updateSeq, res.digest->sequence);
+    EXPECT_EQ(snap.digest, res.digest->digest);
+}
+
+TEST_F(DigestSuite, CancelRestoresPriorDigest) {
+    auto a = engine.submitOrder(LimitOrderRequest{100.0, 1.0, Side::BUY, sym, "A"});
+    auto b = engine.submitOrder(LimitOrderRequest{101.0, 2.0, Side::BUY, sym, "B"});
+    EXPECT_NE(a.digest->digest, b.digest->digest);
+
+    auto cancel = engine.cancelOrder(b.order->orderID);
+    ASSERT_TRUE(cancel.digest.has_value());
+    EXPECT_EQ(cancel.digest->digest, a.digest->digest);
+    EXPECT_GT(cancel.digest->sequence, b.digest->sequence);
+
+    // Cancels are published too, so the snapshot no longer shows the level
+    auto snap = engine.getOrderBookSnapshot(sym, 5).snapshot.value();
+    EXPECT_EQ(snap.bids.size(), 1u);
+    EXPECT_EQ(snap.digest, a.digest->digest);
+}
+
+TEST_F(DigestSuite, PartialFillChangesDigestAndFullFillClearsIt) {
+    auto maker = engine.submitOrder(LimitOrderRequest{100.0, 3.0, Side::SELL, sym, "M"});
+    auto partial = engine.submitOrder(MarketOrderRequest{1.0, Side::BUY, sym, "T1"});
+    EXPECT_NE(partial.digest->digest, maker.digest->digest);
+
+    auto full = engine.submitOrder(MarketOrderRequest{2.0, Side::BUY, sym, "T2"});
+    EXPECT_EQ(full.digest->digest, 0u);
+}
+
+TEST_F(DigestSuite, IcebergReloadIsVisibleInDigest) {
+    engine.submitOrder(IcebergOrderRequest{100.0, 4.0, 2.0, Side::SELL, sym, "ICE"});
+    auto t1 = engine.submitOrder(MarketOrderRequest{2.0, Side::BUY, sym, "T1"});
+    auto t2 = engine.submitOrder(MarketOrderRequest{2.0, Side::BUY, sym, "T2"});
+
+    EXPECT_NE(t1.digest->digest, 0u);
+    EXPECT_EQ(t2.digest->digest, 0u);
+}
@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include "TradingEngine.hpp"
+
+class ExecutionReportSuite : public ::testing::Test {
+protected:
+    TradingEngine engine;
+    const Symbol sym{"BTC/USD"};
+
+    static std::vector<ExecutionReport> drain(SessionEgress* egress) {
+        std::vector<ExecutionReport> reports;
+        ExecutionReport report;
+        while (egress->poll(report)) reports.push_back(report);
+        return reports;
+    }
+};
+
+TEST_F(ExecutionReportSuite, BothSidesOfAFillAreNotified) {
+    SessionEgress* makerSession = engine.openSession(7);
+    SessionEgress* takerSession = engine.openSession(9);
+
+    auto maker = engine.submitOrder(LimitOrderRequest{100.0, 5.0, Side::SELL, sym, "M", 7});
+    auto taker = engine.submitOrder(LimitOrderRequest{100.0, 2.0, Side::BUY, sym, "T", 9});
+
+    auto makerReports = drain(makerSession);
+    ASSERT_EQ(makerReports.size(), 1u);
+    EXPECT_EQ(makerReports[0].orderId, maker.order->orderID);
+    EXPECT_EQ(makerReports[0].counterpartyId, taker.order->orderID);
+    EXPECT_EQ(makerReports[0].side, Side::SELL);
+    EXPECT_TRUE(makerReports[0].isMaker);
+    EXPECT_DOUBLE_EQ(makerReports[0].quantity, 2.0);
+    EXPECT_DOUBLE_EQ(makerReports[0].leavesQuantity, 3.0);
+
+    auto takerReports = drain(takerSession);
+    ASSERT_EQ(takerReports.size(), 1u);
+    EXPECT_EQ(takerReports[0].executionId, makerReports[0].executionId);
+    EXPECT_FALSE(takerReports[0].isMaker);
+    EXPECT_DOUBLE_EQ(takerReports[0].leavesQuantity, 0.0);
+}
+
+TEST_F(ExecutionReportSuite, SweepReportsRunningLeavesPerFill) {
+    SessionEgress* makers = engine.openSession(1);
+    SessionEgress* takers = engine.openSession(2);
+
+    engine.submitOrder(LimitOrderRequest{100.0, 1.0, Side::SELL, sym, "A", 1});
+    engine.submitOrder(LimitOrderRequest{101.0, 1.0, Side::SELL, sym, "B"}); // Anonymous maker
+    engine.submitOrder(IcebergOrderRequest{102.0, 3.0, 1.0, Side::SELL, sym, "ICE", 1});
+    engine.submitOrder(MarketOrderRequest{4.0, Side::BUY, sym, "SWEEP", 2});
+
+    auto takerReports = drain(takers);
+    ASSERT_EQ(takerReports.size(), 4u); // A, B and two iceberg slices
+    std::vector<double> leaves;
+    for (const auto& r : takerReports) leaves.push_back(r.leavesQuantity);
+    EXPECT_EQ(leaves, (std::vector<double>{3.0, 2.0, 1.0, 0.0}));
+
+    auto makerReports = drain(makers);
+    ASSERT_EQ(makerReports.size(), 3u); // Nothing for the anonymous maker
+    EXPECT_DOUBLE_EQ(makerReports.back().leavesQuantity, 1.0); // Iceberg still holds a slice
+}
+
+TEST_F(ExecutionReportSuite, SlowSessionDropsWithoutStallingMatching) {
+    SessionEgress* slow = engine.openSession(3);
+    EXPECT_EQ(engine.openSession(3), slow);
+    EXPECT_EQ(engine.openSession(0), nullptr);
+
+    const size_t makers = Config::EGRESS_RING_CAPACITY + 5;
+    for (size_t i = 0; i < makers; ++i) {
+        engine.submitOrder(LimitOrderRequest{100.0, 1.0, Side::SELL, sym, "M" + std::to_string(i), 3});
+    }
+    auto sweep = engine.submitOrder(MarketOrderRequest{static_cast<double>(makers), Side::BUY, sym, "SWEEP"});
+    EXPECT_EQ(sweep.order->status, OrderStatus::FILLED);
+
+    EXPECT_EQ(drain(slow).size(), Config::EGRESS_RING_CAPACITY);
+    EXPECT_EQ(slow->getDropped(), 5u);
+
+    // Closed sessions get nothing further
+    engine.closeSession(3);
+    engine.submitOrder(LimitOrderRequest{100.0, 1.0, Side::SELL, sym, "LATE", 3});
+    EXPECT_TRUE(engine.submitOrder(MarketOrderRequest{1.0, Side::BUY, sym, "T2"}).isSuccess());
+}
+
+TEST_F(ExecutionReportSuite, ConcurrentPublishersKeepOneSessionInSequence) {
+    SessionEgress egress;
+    constexpr uint64_t perThread = Config::EGRESS_RING_CAPACITY / 4;
+    std::atomic<bool> go{false};
+    auto publisher = [&](OrderID base) {
+        while (!go.load()) {}
+        for (uint64_t i = 0; i < perThread; ++i) {
+            ExecutionReport report{};
+            report.orderId = base + i;
+            egress.publish(report);
+        }
+    };
+    std::thread a(publisher, 1'000'000), b(publisher, 2'000'000);
+    go = true;
+
+    // Read while publishing: every report arrives, and in sequence order
+    uint64_t expected = 1;
+    ExecutionReport report;
+    while (expected <= 2 * perThread) {
+        if (!egress.poll(report)) continue;
+        ASSERT_EQ(report.sequence, expected++);
+    }
+    a.join();
+    b.join();
+    EXPECT_EQ(egress.getDropped(), 0u);
+
+    std::vector<ExecutionReport> window;
+    ASSERT_TRUE(egress.replay(1, 2 * perThread, window));
+    for (uint64_t seq = 1; seq <= window.size(); ++seq) EXPECT_EQ(window[seq - 1].sequence, seq);
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include "TradingEngine.hpp"
+
+class GroupedDepthSuite : public ::testing::Test {
+protected:
+    TradingEngine engine;
+    const Symbol sym{"BTC/USD"};
+};
+
+TEST_F(GroupedDepthSuite, LevelsCollapseIntoBands) {
+    engine.submitOrder(LimitOrderRequest{100.2, 1.0, Side::BUY, sym, "B1"});
+    engine.submitOrder(LimitOrderRequest{100.7, 2.0, Side::BUY, sym, "B2"});
+    engine.submitOrder(LimitOrderRequest{99.5, 4.0, Side::BUY, sym, "B3"});
+    engine.submitOrder(LimitOrderRequest{101.3, 3.0, Side::SELL, sym, "A1"});
+    engine.submitOrder(LimitOrderRequest{101.9, 5.0, Side::SELL, sym, "A2"});
+
+    auto snap = engine.getGroupedOrderBookSnapshot(sym, 1.0, 5).snapshot.value();
+    ASSERT_EQ(snap.bids.size(), 2u);
+    EXPECT_DOUBLE_EQ(snap.bids[0].price, 100.0); // Bids round down
+    EXPECT_DOUBLE_EQ(snap.bids[0].quantity, 3.0);
+    EXPECT_DOUBLE_EQ(snap.bids[1].price, 99.0);
+    ASSERT_EQ(snap.asks.size(), 1u);
+    EXPECT_DOUBLE_EQ(snap.asks[0].price, 102.0); // Asks round up
+    EXPECT_DOUBLE_EQ(snap.asks[0].quantity, 8.0);
+}
+
+TEST_F(GroupedDepthSuite, BucketsFollowFillsAndCancels) {
+    auto b1 = engine.submitOrder(LimitOrderRequest{100.2, 1.0, Side::BUY, sym, "B1"});
+    engine.submitOrder(LimitOrderRequest{100.7, 2.0, Side::BUY, sym, "B2"});
+    engine.submitOrder(MarketOrderRequest{1.5, Side::SELL, sym, "T"});
+    engine.cancelOrder(b1.order->orderID);
+
+    auto snap = engine.getGroupedOrderBookSnapshot(sym, 10.0, 5).snapshot.value();
+    ASSERT_EQ(snap.bids.size(), 1u);
+    EXPECT_DOUBLE_EQ(snap.bids[0].price, 100.0);
+    EXPECT_DOUBLE_EQ(snap.bids[0].quantity, 0.5);
+
+    engine.submitOrder(MarketOrderRequest{0.5, Side::SELL, sym, "T2"});
+    EXPECT_TRUE(engine.getGroupedOrderBookSnapshot(sym, 10.0, 5).snapshot->bids.empty());
+}
+
+TEST_F(GroupedDepthSuite, IcebergContributesOnlyDisplayedSlice) {
+    engine.submitOrder(IcebergOrderRequest{100.0, 10.0, 2.0, Side::SELL, sym, "ICE"});
+    auto snap = engine.getGroupedOrderBookSnapshot(sym, 1.0, 5).snapshot.value();
+    ASSERT_EQ(snap.asks.size(), 1u);
+    EXPECT_DOUBLE_EQ(snap.asks[0].quantity, 2.0);
+}
+
+TEST_F(GroupedDepthSuite, RejectsUnconfiguredBucketSize) {
+    engine.submitOrder(LimitOrderRequest{100.0, 1.0, Side::BUY, sym, "B1"});
+    EXPECT_EQ(engine.getGroupedOrderBookSnapshot(sym, 5.0, 5).code, EngineStatusCode::VALIDATION_FAILURE);
+}
+
+TEST_F(GroupedDepthSuite, DrainedBucketIsExactlyEmptyAndRefillsCleanly) {
+    // Thirds do not sum back to zero exactly in binary; the bucket must not keep the residue
+    engine.submitOrder(LimitOrderRequest{100.1, 0.1, Side::SELL, sym, "A1"});
+    engine.submitOrder(LimitOrderRequest{100.2, 0.2, Side::SELL, sym, "A2"});
+    engine.submitOrder(LimitOrderRequest{102.0, 1.0, Side::SELL, sym, "FAR"});
+    for (int i = 0; i < 3; ++i) engine.submitOrder(MarketOrderRequest{0.1, Side::BUY, sym, "T" + std::to_string(i)});
+
+    auto drained = engine.getGroupedOrderBookSnapshot(sym, 1.0, 5).snapshot.value();
+    ASSERT_EQ(drained.asks.size(), 1u);
+    EXPECT_DOUBLE_EQ(drained.asks[0].price, 102.0);
+
+    engine.submitOrder(LimitOrderRequest{100.5, 0.3, Side::SELL, sym, "BACK"});
+    auto refilled = engine.getGroupedOrderBookSnapshot(sym, 1.0, 5).snapshot.value();
+    ASSERT_EQ(refilled.asks.size(), 2u);
+    EXPECT_EQ(refilled.asks[0].quantity, 0.3);
+}
+
+TEST_F(GroupedDepthSuite, FullWindowIgnoresFarChangesAndRefillsFromBehind) {
+    const size_t window = Config::MAX_GROUPED_DEPTH;
+    std::vector<OrderID> ids;
+    for (size_t i = 0; i < window + 5; ++i) {
+        ids.push_back(engine.submitOrder(LimitOrderRequest{1000.0 - static_cast<double>(i), 1.0, Side::BUY, sym,
+                                                           "B" + std::to_string(i)}).order->orderID);
+    }
+    auto full = engine.getGroupedOrderBookSnapshot(sym, 1.0, window).snapshot.value();
+    ASSERT_EQ(full.bids.size(), window);
+    EXPECT_DOUBLE_EQ(full.bids.back().price, 1000.0 - static_cast<double>(window - 1));
+
+    // Beyond the window: the published ladder carries over unchanged
+    engine.submitOrder(LimitOrderRequest{1.0, 1.0, Side::BUY, sym, "FAR"});
+    engine.cancelOrder(ids.back());
+    auto carried = engine.getGroupedOrderBookSnapshot(sym, 1.0, window).snapshot.value();
+    ASSERT_EQ(carried.bids.size(), window);
+    EXPECT_DOUBLE_EQ(carried.bids.back().price, full.bids.back().price);
+
+    // Emptying a bucket inside it pulls the next one in from behind
+    engine.cancelOrder(ids.front());
+    auto refilled = engine.getGroupedOrderBookSnapshot(sym, 1.0, window).snapshot.value();
+    ASSERT_EQ(refilled.bids.size(), window);
+    EXPECT_DOUBLE_EQ(refilled.bids.front().price, 999.0);
+    EXPECT_DOUBLE_EQ(refilled.bids.back().price, 1000.0 - static_cast<double>(window));
+
+    // A change to the last published bucket is inside the window
+    engine.submitOrder(LimitOrderRequest{1000.0 - static_cast<double>(window), 2.0, Side::BUY, sym, "EDGE"});
+    EXPECT_DOUBLE_EQ(engine.getGroupedOrderBookSnapshot(sym, 1.0, window).snapshot->bids.back().quantity, 3.0);
+}
@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+#include "TradingEngine.hpp"
+
+class IcebergOrderSuite : public ::testing::Test {
+protected:
+    TradingEngine engine;
+    const Symbol sym{"BTC/USD"};
+};
+
+TEST_F(IcebergOrderSuite, SnapshotShowsOnlyDisplayedSlice) {
+    auto res = engine.submitOrder(IcebergOrderRequest{100.0, 10.0, 2.0, Side::SELL, sym, "ICE"});
+    ASSERT_TRUE(res.isSuccess());
+
+    auto snap = engine.getOrderBookSnapshot(sym, 5).snapshot.value();
+    ASSERT_EQ(snap.asks.size(), 1u);
+    EXPECT_DOUBLE_EQ(snap.asks[0].quantity, 2.0);
+
+    // The registry still reports the full remaining size
+    EXPECT_DOUBLE_EQ(engine.getOrderByTag("ICE").order->remainingQuantity, 10.0);
+}
+
+TEST_F(IcebergOrderSuite, ReplenishedSliceLosesTimePriority) {
+    engine.submitOrder(IcebergOrderRequest{100.0, 5.0, 2.0, Side::SELL, sym, "ICE"});
+    engine.submitOrder(LimitOrderRequest{100.0, 3.0, Side::SELL, sym, "PLAIN"});
+
+    // Fills the first slice; the reload goes behind PLAIN
+    engine.submitOrder(MarketOrderRequest{2.0, Side::BUY, sym, "T1"});
+    auto snap = engine.getOrderBookSnapshot(sym, 5).snapshot.value();
+    EXPECT_DOUBLE_EQ(snap.asks[0].quantity, 5.0); // PLAIN 3 + new ICE slice 2
+
+    engine.submitOrder(MarketOrderRequest{3.0, Side::BUY, sym, "T2"});
+    EXPECT_EQ(engine.getOrderByTag("PLAIN").order->status, OrderStatus::FILLED);
+    EXPECT_EQ(engine.getOrderByTag("ICE").order->status, OrderStatus::ACTIVE);
+    EXPECT_DOUBLE_EQ(engine.getOrderByTag("ICE").order->remainingQuantity, 3.0);
+}
+
+TEST_F(IcebergOrderSuite, SingleTakerConsumesSeveralSlices) {
+    engine.submitOrder(IcebergOrderRequest{100.0, 5.0, 2.0, Side::SELL, sym, "ICE"});
+
+    auto res = engine.submitOrder(MarketOrderRequest{5.0, Side::BUY, sym, "TAKER"});
+    EXPECT_EQ(res.order->status, OrderStatus::FILLED);
+    EXPECT_EQ(engine.getOrderByTag("ICE").order->status, OrderStatus::FILLED);
+    EXPECT_TRUE(engine.getOrderBookSnapshot(sym, 5).snapshot->asks.empty());
+}
+
+TEST_F(IcebergOrderSuite, CancelReturnsDisplayedAndHidden) {
+    auto res = engine.submitOrder(IcebergOrderRequest{100.0, 10.0, 2.0, Side::BUY, sym, "ICE"});
+    engine.submitOrder(MarketOrderRequest{1.0, Side::SELL, sym, "TAKER"});
+
+    ASSERT_TRUE(engine.cancelOrder(res.order->orderID).isSuccess());
+    EXPECT_DOUBLE_EQ(res.order->remainingQuantity, 9.0);
+    EXPECT_TRUE(engine.getOrderBookSnapshot(sym, 5).snapshot->bids.empty());
+}
+
+TEST_F(IcebergOrderSuite, RejectsDisplayLargerThanQuantity) {
+    auto res = engine.submitOrder(IcebergOrderRequest{100.0, 1.0, 2.0, Side::BUY, sym, "ICE"});
+    EXPECT_EQ(res.code, EngineStatusCode::VALIDATION_FAILURE);
+}
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include "IdleScheduler.hpp"
+#include "TradingEngine.hpp"
+
+class IdleSchedulerSuite : public ::testing::Test {
+protected:
+    TradingEngine engine;
+    IdleScheduler idle;
+    const Symbol sym{"BTC/USD"};
+
+    static bool never() { return false; }
+};
+
+TEST_F(IdleSchedulerSuite, YieldsBetweenSlicesAsSoonAsInputArrives) {
+    int slices = 0;
+    idle.addTask("busy", [&] { ++slices; return true; });
+
+    // Input "arrives" after the third slice: the fourth must not start
+    size_t ran = idle.runIdle(std::chrono::seconds(10), [&] { return slices >= 3; });
+
+    EXPECT_EQ(ran, 3u);
+    EXPECT_EQ(slices, 3);
+    EXPECT_TRUE(idle.hasPendingWork());
+}
+
+TEST_F(IdleSchedulerSuite, RoundRobinsAndStopsWhenAllTasksDrain) {
+    int a = 0, b = 0;
+    idle.addTask("a", [&] { return ++a < 3; });
+    idle.addTask("b", [&] { ++b; return false; });
+
+    size_t ran = idle.runIdle(std::chrono::seconds(10), never);
+
+    EXPECT_EQ(a, 3);
+    EXPECT_EQ(b, 1); // Drained tasks are not revisited within the same idle period
+    EXPECT_EQ(ran, 4u);
+    EXPECT_FALSE(idle.hasPendingWork());
+}
+
+TEST_F(IdleSchedulerSuite, ArchivedOrdersStayQueryable) {
+    auto maker = engine.submitOrder(LimitOrderRequest{100.0, 1.0, Side::SELL, sym, "M"});
+    auto taker = engine.submitOrder(LimitOrderRequest{100.0, 1.0, Side::BUY, sym, "T"});
+    auto resting = engine.submitOrder(LimitOrderRequest{99.0, 1.0, Side::BUY, sym, "R"});
+    auto cancelled = engine.submitOrder(LimitOrderRequest{98.0, 2.0, Side::BUY, sym, "C"});
+    engine.cancelOrder(cancelled.order->orderID);
+
+    // Filled maker, filled taker and the cancel; the resting order is not a candidate
+    EXPECT_EQ(engine.archiveTerminalOrders(Config::ARCHIVE_BATCH), 3u);
+    EXPECT_EQ(engine.archiveTerminalOrders(Config::ARCHIVE_BATCH), 0u);
+
+    auto m = engine.getOrder(maker.order->orderID);
+    ASSERT_TRUE(m.isSuccess());
+    EXPECT_EQ(m.order->status, OrderStatus::FILLED);
+    EXPECT_DOUBLE_EQ(m.order->cumulativeCost, 100.0);
+
+    auto c = engine.getOrderByTag("C");
+    ASSERT_TRUE(c.isSuccess());
+    EXPECT_EQ(c.order->status, OrderStatus::CANCELLED);
+    EXPECT_DOUBLE_EQ(c.order->remainingQuantity, 2.0);
+
+    EXPECT_EQ(engine.cancelOrder(taker.order->orderID).code, EngineStatusCode::ALREADY_TERMINAL);
+    EXPECT_TRUE(engine.cancelOrder(resting.order->orderID).isSuccess());
+}
+
+TEST_F(IdleSchedulerSuite, ArchivalIsBoundedPerSlice) {
+    for (int i = 0; i < 10; ++i) {
+        auto r = engine.submitOrder(LimitOrderRequest{100.0, 1.0, Side::BUY, sym, "B" + std::to_string(i)});
+        engine.cancelOrder(r.order->orderID);
+    }
+
+    idle.addTask("archive", [&] { return engine.archiveTerminalOrders(4) == 4; });
+    idle.addTask("warm", [&] { engine.warmBooks(); return false; });
+
+    EXPECT_EQ(idle.runIdle(std::chrono::seconds(10), never), 4u); // 4 + 4 + 2 archived, plus one warm
+    EXPECT_EQ(engine.archiveTerminalOrders(Config::ARCHIVE_BATCH), 0u);
+    EXPECT_EQ(engine.getOrderByTag("B9").order->status, OrderStatus::CANCELLED);
+}
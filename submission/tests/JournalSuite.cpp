@@ -0,0 +1,337 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <random>
+#include <thread>
+#include <chrono>
+#include <csignal>
+#include <sys/resource.h>
+#include "TradingEngine.hpp"
+
+class JournalSuite : public ::testing::Test {
+protected:
+    const Symbol btc{"BTC/USD"};
+    const Symbol eth{"ETH/USD"};
+    std::string path;
+
+    void SetUp() override {
+        path = (std::filesystem::temp_directory_path() /
+                ("journal_" + std::to_string(::getpid()) + ".jnl")).string();
+        std::filesystem::remove(path);
+    }
+    void TearDown() override { std::filesystem::remove(path); }
+
+    std::vector<JournalRecord> readAll() const {
+        JournalReader reader;
+        EXPECT_TRUE(reader.open(path).empty());
+        std::vector<JournalRecord> records;
+        for (JournalRecord rec; reader.next(rec);) records.push_back(rec);
+        return records;
+    }
+};
+
+TEST_F(JournalSuite, RecordsRoundTripExactly) {
+    Order limit(50123.45678901, 1.25, 1.25, 0.0, Side::BUY, OrderType::LIMIT, OrderStatus::ACTIVE, btc, "client-0001");
+    Order iceberg(3012.5, 10.0, 10.0, 0.0, Side::SELL, OrderType::LIMIT, OrderStatus::ACTIVE, eth, "client-0002");
+    iceberg.displayQuantity = 0.5;
+    iceberg.session = 7;
+    Order pegged(0.0, 0.001, 0.001, 0.0, Side::BUY, OrderType::PEGGED, OrderStatus::ACTIVE, btc, "other");
+    pegged.pegType = PegType::MID;
+    Order lower(50100.0, 2.0, 2.0, 0.0, Side::SELL, OrderType::LIMIT, OrderStatus::ACTIVE, btc, "client-0003");
+    {
+        JournalWriter writer;
+        ASSERT_TRUE(writer.open(path).empty());
+        writer.appendOrder(limit);
+        writer.appendOrder(iceberg);
+        writer.appendOrder(pegged);
+        writer.appendCancel(limit.orderID);
+        writer.appendOrder(lower); // Negative price delta within the symbol
+        EXPECT_EQ(writer.getRecordCount(), 5u);
+    }
+
+    auto records = readAll();
+    ASSERT_EQ(records.size(), 5u);
+    auto expectOrder = [](const JournalRecord& rec, const Order& o) {
+        EXPECT_EQ(rec.type, JournalRecordType::ORDER);
+        EXPECT_EQ(rec.orderId, o.orderID);
+        EXPECT_EQ(rec.timestamp, o.timestamp);
+        EXPECT_EQ(rec.symbol, o.symbol);
+        EXPECT_EQ(rec.side, o.side);
+        EXPECT_EQ(rec.orderType, o.type);
+        EXPECT_EQ(rec.pegType, o.pegType);
+        EXPECT_DOUBLE_EQ(rec.price, o.price);
+        EXPECT_DOUBLE_EQ(rec.quantity, o.originalQuantity);
+        EXPECT_DOUBLE_EQ(rec.displayQuantity, o.displayQuantity);
+        EXPECT_EQ(rec.session, o.session);
+        EXPECT_EQ(rec.tag, o.tag);
+    };
+    expectOrder(records[0], limit);
+    expectOrder(records[1], iceberg);
+    expectOrder(records[2], pegged);
+    EXPECT_EQ(records[3].type, JournalRecordType::CANCEL);
+    EXPECT_EQ(records[3].orderId, limit.orderID);
+    expectOrder(records[4], lower);
+}
+
+TEST_F(JournalSuite, SequentialFlowEncodesInAFewBytesPerOrder) {
+    constexpr size_t orders = 10000;
+    JournalWriter writer;
+    ASSERT_TRUE(writer.open(path).empty());
+    for (size_t i = 0; i < orders; ++i) {
+        Order o(100.0 + static_cast<double>(i % 20) * 0.5, 1.0 + static_cast<double>(i % 3), 0.0, 0.0,
+                (i % 2) ? Side::SELL : Side::BUY, OrderType::LIMIT, OrderStatus::ACTIVE,
+                (i % 4) ? btc : eth, "ord-" + std::to_string(100000 + i));
+        writer.appendOrder(o);
+    }
+    writer.commit();
+
+    // Fixed-width layout would be ~100 bytes per order (ids, timestamp, doubles, symbol, tag)
+    EXPECT_LT(std::filesystem::file_size(path), orders * 24);
+    EXPECT_EQ(readAll().size(), orders);
+}
+
+TEST_F(JournalSuite, SeekLandsOnAnyRecordAcrossBlocks) {
+    constexpr size_t orders = 20000; // Several blocks
+    std::vector<OrderID> ids;
+    {
+        JournalWriter writer;
+        ASSERT_TRUE(writer.open(path).empty());
+        for (size_t i = 0; i < orders; ++i) {
+            Order o(100.0 + static_cast<double>(i % 7), 1.0, 1.0, 0.0, Side::BUY, OrderType::LIMIT,
+                    OrderStatus::ACTIVE, btc, "seek-" + std::to_string(i));
+            ids.push_back(o.orderID);
+            writer.appendOrder(o);
+        }
+    }
+    ASSERT_GT(std::filesystem::file_size(path), 2 * Config::JOURNAL_BLOCK_BYTES);
+
+    JournalReader reader;
+    ASSERT_TRUE(reader.open(path).empty());
+    for (size_t index : {size_t{0}, size_t{1}, orders / 2, orders - 1, size_t{7777}}) {
+        ASSERT_TRUE(reader.seek(index)) << index;
+        JournalRecord rec;
+        ASSERT_TRUE(reader.next(rec));
+        EXPECT_EQ(rec.orderId, ids[index]);
+        EXPECT_EQ(rec.tag, "seek-" + std::to_string(index));
+    }
+    EXPECT_FALSE(reader.seek(orders));
+}
+
+TEST_F(JournalSuite, FullBlocksAreSyncedWithoutACommit) {
+    JournalWriter writer;
+    ASSERT_TRUE(writer.open(path).empty());
+    size_t appended = 0;
+    while (writer.getBytesWritten() == 0 && appended < 100000) {
+        Order o(100.0, 1.0, 1.0, 0.0, Side::BUY, OrderType::LIMIT, OrderStatus::ACTIVE, btc,
+                "bg-" + std::to_string(appended++));
+        writer.appendOrder(o);
+        if (appended % 1000 == 0) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    // The sealed block reached the disk on the syncer thread; the open one waits for commit()
+    ASSERT_GT(writer.getBytesWritten(), Config::JOURNAL_BLOCK_BYTES);
+    writer.appendOrder(Order(100.0, 1.0, 1.0, 0.0, Side::BUY, OrderType::LIMIT, OrderStatus::ACTIVE, btc,
+                             "bg-" + std::to_string(appended++)));
+    size_t synced = readAll().size();
+    EXPECT_GT(synced, 0u);
+    EXPECT_LT(synced, appended);
+
+    EXPECT_TRUE(writer.commit().empty());
+    EXPECT_EQ(readAll().size(), appended);
+}
+
+TEST_F(JournalSuite, TornTailIsDroppedAndAppendingResumesAfterIt) {
+    Order first(100.0, 1.0, 1.0, 0.0, Side::BUY, OrderType::LIMIT, OrderStatus::ACTIVE, btc, "A");
+    Order second(101.0, 1.0, 1.0, 0.0, Side::BUY, OrderType::LIMIT, OrderStatus::ACTIVE, btc, "B");
+    {
+        JournalWriter writer;
+        ASSERT_TRUE(writer.open(path).empty());
+        writer.appendOrder(first);
+        writer.commit();
+        writer.appendOrder(second);
+    }
+    // Crash in the middle of the second block
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 3);
+    ASSERT_EQ(readAll().size(), 1u);
+
+    {
+        JournalWriter writer;
+        ASSERT_TRUE(writer.open(path).empty());
+        EXPECT_EQ(writer.getRecordCount(), 1u);
+        writer.appendOrder(second);
+    }
+    auto records = readAll();
+    ASSERT_EQ(records.size(), 2u);
+    EXPECT_EQ(records[1].tag, "B");
+}
+
+TEST_F(JournalSuite, ReplayReproducesBooksFillsAndIdentities) {
+    OrderBookSnapshot beforeBtc, beforeEth;
+    OrderID lastId = 0;
+    {
+        TradingEngine engine;
+        ASSERT_TRUE(engine.attachJournal(path).isSuccess());
+        engine.submitOrder(LimitOrderRequest{100.0, 1.0, Side::BUY, btc, "B1"});
+        engine.submitOrder(LimitOrderRequest{100.0, 2.0, Side::BUY, btc, "B2"});
+        engine.submitOrder(IcebergOrderRequest{101.0, 5.0, 1.0, Side::SELL, btc, "ICE"});
+        engine.submitOrder(PeggedOrderRequest{PegType::PRIMARY, 1.5, Side::BUY, btc, "PEG"});
+        engine.submitOrder(LimitOrderRequest{101.0, 1.5, Side::BUY, btc, "HIT"});
+        engine.submitOrder(LimitOrderRequest{2000.0, 3.0, Side::SELL, eth, "E1"});
+        engine.submitOrder(MarketOrderRequest{1.0, Side::BUY, eth, "EM"});
+        engine.cancelOrderByTag("B2");
+        lastId = engine.submitOrder(LimitOrderRequest{99.5, 1.0, Side::BUY, btc, "LAST"}).order->orderID;
+        beforeBtc = engine.getOrderBookSnapshot(btc, 10).snapshot.value();
+        beforeEth = engine.getOrderBookSnapshot(eth, 10).snapshot.value();
+    }
+
+    TradingEngine restarted;
+    auto resp = restarted.attachJournal(path);
+    ASSERT_TRUE(resp.isSuccess()) << resp.message;
+    EXPECT_EQ(resp.message, "Replayed 9 journal records");
+
+    EXPECT_EQ(restarted.getOrderBookSnapshot(btc, 10).snapshot->digest, beforeBtc.digest);
+    EXPECT_EQ(restarted.getOrderBookSnapshot(eth, 10).snapshot->digest, beforeEth.digest);
+    EXPECT_EQ(restarted.getOrderByTag("B2").order->status, OrderStatus::CANCELLED);
+    EXPECT_EQ(restarted.getOrderByTag("LAST").order->orderID, lastId);
+
+    // New orders get fresh ids, replayed tags still collide, and the journal keeps growing
+    auto next = restarted.submitOrder(LimitOrderRequest{99.0, 1.0, Side::BUY, btc, "NEXT"});
+    EXPECT_GT(next.order->orderID, lastId);
+    EXPECT_EQ(restarted.submitOrder(LimitOrderRequest{99.0, 1.0, Side::BUY, btc, "LAST"}).code,
+              EngineStatusCode::DUPLICATE_TAG);
+    restarted.commitJournal();
+    EXPECT_EQ(readAll().size(), 10u);
+}
+
+TEST_F(JournalSuite, ParallelRecoveryMatchesSerialReplay) {
+    const std::vector<Symbol> symbols{Symbol("BTC/USD"), Symbol("ETH/USD"), Symbol("SOL/USD"),
+                                      Symbol("XRP/USD"), Symbol("ADA/USD")};
+    std::vector<std::string> tags;
+    {
+        TradingEngine engine;
+        ASSERT_TRUE(engine.attachJournal(path).isSuccess());
+        std::mt19937 rng(42);
+        for (int i = 0; i < 5000; ++i) {
+            const Symbol& sym = symbols[rng() % symbols.size()];
+            Side side = (rng() % 2) ? Side::BUY : Side::SELL;
+            std::string tag = "T" + std::to_string(i);
+            double qty = 1.0 + static_cast<double>(rng() % 4);
+            switch (rng() % 10) {
+                case 0: engine.submitOrder(MarketOrderRequest{qty, side, sym, tag}); break;
+                case 1: engine.submitOrder(IcebergOrderRequest{100.0 + (rng() % 10) * 0.5, qty * 2, 1.0, side, sym, tag}); break;
+                case 2: engine.submitOrder(PeggedOrderRequest{PegType::PRIMARY, qty, side, sym, tag}); break;
+                case 3: if (!tags.empty()) engine.cancelOrderByTag(tags[rng() % tags.size()]); break;
+                default: engine.submitOrder(LimitOrderRequest{100.0 + (rng() % 10) * 0.5, qty, side, sym, tag});
+            }
+            tags.push_back(tag);
+        }
+    }
+
+    TradingEngine serial, parallel;
+    ASSERT_TRUE(serial.attachJournal(path, 1).isSuccess());
+    ASSERT_TRUE(parallel.attachJournal(path, 4).isSuccess());
+
+    for (const Symbol& sym : symbols) {
+        auto a = serial.getOrderBookSnapshot(sym, 100).snapshot.value();
+        auto b = parallel.getOrderBookSnapshot(sym, 100).snapshot.value();
+        EXPECT_EQ(a.digest, b.digest);
+        EXPECT_EQ(a.updateSeq, b.updateSeq);
+        ASSERT_EQ(a.bids.size(), b.bids.size());
+        ASSERT_EQ(a.asks.size(), b.asks.size());
+        for (size_t i = 0; i < a.bids.size(); ++i) EXPECT_DOUBLE_EQ(a.bids[i].quantity, b.bids[i].quantity);
+        for (size_t i = 0; i < a.asks.size(); ++i) EXPECT_DOUBLE_EQ(a.asks[i].quantity, b.asks[i].quantity);
+    }
+    for (const std::string& tag : tags) {
+        auto a = serial.getOrderByTag(tag), b = parallel.getOrderByTag(tag);
+        ASSERT_EQ(a.isSuccess(), b.isSuccess()) << tag;
+        if (!a.isSuccess()) continue;
+        EXPECT_EQ(a.order->orderID, b.order->orderID);
+        EXPECT_EQ(a.order->status, b.order->status) << tag;
+        EXPECT_DOUBLE_EQ(a.order->remainingQuantity, b.order->remainingQuantity) << tag;
+        EXPECT_DOUBLE_EQ(a.order->cumulativeCost, b.order->cumulativeCost) << tag;
+    }
+
+    // Same terminal backlog and the same execution id sequence going forward
+    EXPECT_EQ(serial.archiveTerminalOrders(100000), parallel.archiveTerminalOrders(100000));
+    auto a = serial.submitOrder(MarketOrderRequest{3.0, Side::BUY, symbols[0], "AFTER"});
+    auto b = parallel.submitOrder(MarketOrderRequest{3.0, Side::BUY, symbols[0], "AFTER"});
+    ASSERT_EQ(a.fills.size(), b.fills.size());
+    for (size_t i = 0; i < a.fills.size(); ++i) {
+        EXPECT_EQ(a.fills[i].executionId, b.fills[i].executionId);
+        EXPECT_EQ(a.fills[i].makerOrderId, b.fills[i].makerOrderId);
+    }
+}
+
+TEST_F(JournalSuite, OffTickValuesRoundTripBitExact) {
+    Order fine(100.000000000123, 3e-9, 3e-9, 0.0, Side::BUY, OrderType::LIMIT, OrderStatus::ACTIVE, btc, "fine");
+    fine.displayQuantity = 1e-10;
+    Order huge(1e300, 0.1, 0.1, 0.0, Side::SELL, OrderType::LIMIT, OrderStatus::ACTIVE, btc, "huge");
+    Order grid(99.5, 2.0, 2.0, 0.0, Side::BUY, OrderType::LIMIT, OrderStatus::ACTIVE, btc, "grid");
+    {
+        JournalWriter writer;
+        ASSERT_TRUE(writer.open(path).empty());
+        writer.appendOrder(grid);
+        writer.appendOrder(fine);
+        writer.appendOrder(huge);
+        writer.appendOrder(grid); // Delta base is still the last on-grid price
+    }
+
+    auto records = readAll();
+    ASSERT_EQ(records.size(), 4u);
+    EXPECT_EQ(records[1].price, fine.price);
+    EXPECT_EQ(records[1].quantity, 3e-9);
+    EXPECT_EQ(records[1].displayQuantity, 1e-10);
+    EXPECT_EQ(records[2].price, 1e300);
+    EXPECT_EQ(records[2].quantity, 0.1);
+    EXPECT_EQ(records[3].price, 99.5);
+    EXPECT_EQ(records[3].quantity, 2.0);
+}
+
+TEST_F(JournalSuite, FailedCommitKeepsTheBlockAndRetries) {
+    TradingEngine engine;
+    ASSERT_TRUE(engine.attachJournal(path).isSuccess());
+    engine.submitOrder(LimitOrderRequest{100.0, 1.0, Side::BUY, btc, "A"});
+    ASSERT_TRUE(engine.commitJournal().isSuccess());
+    const auto intact = std::filesystem::file_size(path);
+
+    for (int i = 0; i < 20; ++i) {
+        engine.submitOrder(LimitOrderRequest{90.0 - i, 1.0, Side::BUY, btc, "B" + std::to_string(i)});
+    }
+    // Cap the file just past the first block so the next frame is written only in part
+    rlimit saved{};
+    ASSERT_EQ(::getrlimit(RLIMIT_FSIZE, &saved), 0);
+    auto previous = std::signal(SIGXFSZ, SIG_IGN);
+    rlimit capped = saved;
+    capped.rlim_cur = intact + 16;
+    ASSERT_EQ(::setrlimit(RLIMIT_FSIZE, &capped), 0);
+    EngineResponse failed = engine.commitJournal();
+    ::setrlimit(RLIMIT_FSIZE, &saved);
+    std::signal(SIGXFSZ, previous);
+
+    EXPECT_EQ(failed.code, EngineStatusCode::JOURNAL_FAILURE);
+    EXPECT_EQ(std::filesystem::file_size(path), intact);
+    EXPECT_EQ(readAll().size(), 1u);
+
+    // The kept block goes out on the next commit, ahead of anything newer
+    engine.submitOrder(LimitOrderRequest{50.0, 1.0, Side::BUY, btc, "C"});
+    EXPECT_TRUE(engine.commitJournal().isSuccess());
+    auto records = readAll();
+    ASSERT_EQ(records.size(), 22u);
+    EXPECT_EQ(records[1].tag, "B0");
+    EXPECT_EQ(records.back().tag, "C");
+}
+
+TEST_F(JournalSuite, StoreAndJournalAreNotCombined) {
+    const std::string storePath = path + ".store";
+    std::filesystem::remove(storePath);
+    {
+        TradingEngine engine;
+        ASSERT_TRUE(engine.attachStore(storePath, 16).isSuccess());
+        EXPECT_EQ(engine.attachJournal(path).code, EngineStatusCode::JOURNAL_FAILURE);
+    }
+    {
+        TradingEngine engine;
+        ASSERT_TRUE(engine.attachJournal(path).isSuccess());
+        EXPECT_EQ(engine.attachStore(storePath + "2", 16).code, EngineStatusCode::STORE_FAILURE);
+    }
+    EXPECT_FALSE(std::filesystem::exists(storePath + "2"));
+    std::filesystem::remove(storePath);
+}
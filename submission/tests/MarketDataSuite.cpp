@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstring>
+#include "TradingEngine.hpp"
+#include "MarketDataPublisher.hpp"
+
+class MarketDataSuite : public ::testing::Test {
+protected:
+    TradingEngine engine;
+    const Symbol sym{"BTC/USD"};
+
+    static std::vector<MarketDataEvent> drain(MarketDataCursor& cursor) {
+        std::vector<MarketDataEvent> events;
+        MarketDataEvent event;
+        while (cursor.poll(event) == CursorStatus::OK) events.push_back(event);
+        return events;
+    }
+};
+
+TEST_F(MarketDataSuite, BookEmitsLevelChangesAndTrades) {
+    engine.enableMarketData();
+    engine.submitOrder(LimitOrderRequest{100.0, 2.0, Side::SELL, sym, "M1"});
+    engine.submitOrder(LimitOrderRequest{100.0, 1.0, Side::SELL, sym, "M2"});
+    engine.submitOrder(MarketOrderRequest{2.5, Side::BUY, sym, "T"});
+
+    auto rings = engine.getMarketDataRings();
+    ASSERT_EQ(rings.size(), 1u);
+    MarketDataCursor cursor(*rings[0]);
+    auto events = drain(cursor);
+
+    // Two adds, then per fill: the level shrinks and the trade prints
+    ASSERT_EQ(events.size(), 6u);
+    std::vector<double> levelVolumes, tradeSizes;
+    for (size_t i = 0; i < events.size(); ++i) {
+        EXPECT_EQ(events[i].sequence, i + 1);
+        EXPECT_EQ(events[i].symbol, sym);
+        if (events[i].kind == MarketDataKind::LEVEL) {
+            EXPECT_EQ(events[i].side, Side::SELL);
+            levelVolumes.push_back(events[i].quantity);
+        } else {
+            EXPECT_EQ(events[i].side, Side::BUY); // Aggressor
+            tradeSizes.push_back(events[i].quantity);
+        }
+    }
+    EXPECT_EQ(levelVolumes, (std::vector<double>{2.0, 3.0, 1.0, 0.5}));
+    EXPECT_EQ(tradeSizes, (std::vector<double>{2.0, 0.5}));
+}
+
+TEST_F(MarketDataSuite, SubscribersReadTheSameRingIndependently) {
+    engine.enableMarketData();
+    engine.submitOrder(LimitOrderRequest{100.0, 1.0, Side::BUY, sym, "A"});
+    const MarketDataRing* ring = engine.getMarketDataRings().at(0);
+
+    MarketDataCursor early(*ring);
+    MarketDataCursor late(*ring, false); // Joins at the live edge
+    engine.submitOrder(LimitOrderRequest{101.0, 1.0, Side::BUY, sym, "B"});
+
+    EXPECT_EQ(drain(early).size(), 2u);
+    auto fromLate = drain(late);
+    ASSERT_EQ(fromLate.size(), 1u);
+    EXPECT_EQ(fromLate[0].sequence, 2u);
+
+    // Reading consumes nothing: a third reader still sees the full history
+    MarketDataCursor third(*ring);
+    EXPECT_EQ(drain(third).size(), 2u);
+}
+
+TEST_F(MarketDataSuite, LappedSubscriberIsDetectedAndResyncsFromASnapshot) {
+    engine.enableMarketData();
+    engine.submitOrder(LimitOrderRequest{100.0, 1.0, Side::BUY, sym, "SEED"});
+    const MarketDataRing* ring = engine.getMarketDataRings().at(0);
+    MarketDataCursor slow(*ring);
+
+    // The writer laps the idle reader and never waits for it
+    for (size_t i = 0; i < Config::MD_RING_CAPACITY; ++i) {
+        engine.submitOrder(LimitOrderRequest{100.0, 1.0, Side::BUY, sym, "L" + std::to_string(i)});
+    }
+    MarketDataEvent event;
+    EXPECT_EQ(slow.poll(event), CursorStatus::LAPPED);
+    EXPECT_EQ(slow.poll(event), CursorStatus::LAPPED);
+
+    auto snap = engine.getOrderBookSnapshot(sym, 10).snapshot;
+    ASSERT_TRUE(snap.has_value());
+    EXPECT_EQ(snap->marketDataSeq, ring->getLastSequence());
+    slow.resync(snap->marketDataSeq);
+    EXPECT_EQ(slow.poll(event), CursorStatus::EMPTY);
+
+    engine.submitOrder(LimitOrderRequest{99.0, 1.0, Side::BUY, sym, "NEXT"});
+    ASSERT_EQ(slow.poll(event), CursorStatus::OK);
+    EXPECT_EQ(event.sequence, snap->marketDataSeq + 1);
+    EXPECT_DOUBLE_EQ(event.price, 99.0);
+}
+
+TEST_F(MarketDataSuite, PublisherBatchesEventsIntoDatagrams) {
+    int receiver = ::socket(AF_INET, SOCK_DGRAM, 0);
+    ASSERT_GE(receiver, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    ASSERT_EQ(::bind(receiver, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)), 0);
+    socklen_t len = sizeof(addr);
+    ::getsockname(receiver, reinterpret_cast<sockaddr*>(&addr), &len);
+    timeval timeout{2, 0};
+    ::setsockopt(receiver, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    MarketDataPublisher publisher(engine);
+    EXPECT_FALSE(publisher.addEndpoint("localhost").empty());
+    ASSERT_EQ(publisher.addEndpoint("127.0.0.1:" + std::to_string(ntohs(addr.sin_port))), "");
+
+    // Queued before the publisher starts, so they leave in full datagrams
+    engine.enableMarketData();
+    const size_t orders = Config::MD_EVENTS_PER_DATAGRAM + 5;
+    for (size_t i = 0; i < orders; ++i) {
+        engine.submitOrder(LimitOrderRequest{100.0 + i, 1.0, Side::SELL, sym, "M" + std::to_string(i)});
+    }
+    publisher.start();
+    publisher.stop();
+    EXPECT_EQ(publisher.getEventsSent(), orders);
+    EXPECT_EQ(publisher.getDatagramsSent(), 2u);
+    EXPECT_EQ(publisher.getSendErrors(), 0u);
+
+    std::vector<MarketDataEvent> received;
+    uint64_t expectedPacket = 1;
+    char buffer[Config::MD_MAX_DATAGRAM];
+    while (received.size() < orders) {
+        ssize_t n = ::recv(receiver, buffer, sizeof(buffer), 0);
+        ASSERT_GT(n, 0);
+        MarketDataPacketHeader header;
+        std::memcpy(&header, buffer, sizeof(header));
+        EXPECT_EQ(header.magic, MarketDataPacketHeader::MAGIC);
+        EXPECT_EQ(header.packetSequence, expectedPacket++);
+        ASSERT_EQ(static_cast<size_t>(n), sizeof(header) + header.count * sizeof(MarketDataEvent));
+        for (size_t i = 0; i < header.count; ++i) {
+            MarketDataEvent event;
+            std::memcpy(&event, buffer + sizeof(header) + i * sizeof(event), sizeof(event));
+            received.push_back(event);
+        }
+    }
+    ::close(receiver);
+
+    for (size_t i = 0; i < received.size(); ++i) {
+        EXPECT_EQ(received[i].sequence, i + 1);
+        EXPECT_DOUBLE_EQ(received[i].price, 100.0 + i);
+        // Alignment gaps travel as zeros, never as leftover memory
+        EXPECT_TRUE(std::ranges::all_of(received[i].reserved0, [](uint8_t b) { return b == 0; }));
+        EXPECT_TRUE(std::ranges::all_of(received[i].reserved1, [](uint8_t b) { return b == 0; }));
+    }
+}
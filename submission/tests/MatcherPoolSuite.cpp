@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+#include "TradingEngine.hpp"
+#include "MatcherPool.hpp"
+
+class MatcherPoolSuite : public ::testing::Test {
+protected:
+    TradingEngine engine;
+
+    static void submitUntilAccepted(MatcherPool& pool, MatcherTask task) {
+        while (!pool.submit(task)) std::this_thread::yield();
+    }
+};
+
+TEST_F(MatcherPoolSuite, BooksMatchInParallelAndKeepArrivalOrder) {
+    const std::vector<Symbol> symbols{Symbol("BTC/USD"), Symbol("ETH/USD"), Symbol("SOL/USD"), Symbol("XRP/USD")};
+    constexpr int perSide = 500;
+    std::atomic<int> replies{0};
+    std::atomic<size_t> fills{0};
+    {
+        MatcherPool pool(engine, 3);
+        ASSERT_TRUE(pool.start());
+        std::vector<std::thread> producers;
+        for (const Symbol& sym : symbols) {
+            producers.emplace_back([&, sym] {
+                auto count = [&](EngineResponse&& resp) {
+                    fills.fetch_add(resp.fills.size());
+                    replies.fetch_add(1);
+                };
+                for (int i = 0; i < perSide; ++i) {
+                    submitUntilAccepted(pool, {LimitOrderRequest{100.0, 1.0, Side::SELL, sym, sym.name() + "-S" + std::to_string(i)}, count});
+                }
+                for (int i = 0; i < perSide; ++i) {
+                    submitUntilAccepted(pool, {LimitOrderRequest{100.0, 1.0, Side::BUY, sym, sym.name() + "-B" + std::to_string(i)}, count});
+                }
+            });
+        }
+        for (auto& t : producers) t.join();
+        pool.stop();
+    }
+
+    EXPECT_EQ(replies.load(), static_cast<int>(symbols.size()) * perSide * 2);
+    EXPECT_EQ(fills.load(), symbols.size() * perSide);
+    for (const Symbol& sym : symbols) {
+        auto snap = engine.getOrderBookSnapshot(sym, 5).snapshot.value();
+        EXPECT_TRUE(snap.bids.empty());
+        EXPECT_TRUE(snap.asks.empty());
+        // Arrival order: the first buy took the first sell
+        auto first = engine.getOrderByTag(sym.name() + "-S0").order;
+        EXPECT_EQ(first->status, OrderStatus::FILLED);
+    }
+}
+
+TEST_F(MatcherPoolSuite, HotLaneMigratesWithoutLosingOrReorderingRequests) {
+    // Lanes are placed round-robin: A -> 0, B -> 1, C -> 0. A and C are hot, B idle.
+    const Symbol a("AAA/USD"), b("BBB/USD"), c("CCC/USD");
+    MatcherPool pool(engine, 2);
+    std::mutex seenMutex;
+    std::unordered_map<std::string, std::vector<OrderID>> seen;
+    auto record = [&](EngineResponse&& resp) {
+        ASSERT_TRUE(resp.isSuccess()) << resp.message;
+        std::lock_guard lock(seenMutex);
+        seen[resp.order->symbol.name()].push_back(resp.order->orderID);
+    };
+    for (const Symbol* sym : {&a, &b, &c}) submitUntilAccepted(pool, {CancelRequest{0, *sym}, {}});
+    ASSERT_EQ(pool.getOwner(a), pool.getOwner(c));
+    ASSERT_TRUE(pool.start());
+
+    std::atomic<bool> flooding{true};
+    std::vector<int> sent(2, 0);
+    std::thread producer([&] {
+        for (int i = 0; flooding.load(); ++i) {
+            // Resting orders on distinct levels: cheap, and every reply carries a fresh id
+            double px = 100.0 + (i % 50) * 0.01;
+            for (int k = 0; k < 2; ++k) {
+                const Symbol& sym = k ? c : a;
+                submitUntilAccepted(pool, {LimitOrderRequest{px, 1.0, Side::BUY, sym, sym.name() + std::to_string(i)}, record});
+                ++sent[k];
+            }
+        }
+    });
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (pool.getOwner(a) == pool.getOwner(c) && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20)); // Keep flooding across the hand-over
+    flooding = false;
+    producer.join();
+    pool.stop();
+
+    EXPECT_NE(pool.getOwner(a), pool.getOwner(c));
+    EXPECT_GE(pool.getMigrations(), 1u);
+    for (int k = 0; k < 2; ++k) {
+        const auto& ids = seen[(k ? c : a).name()];
+        EXPECT_EQ(ids.size(), static_cast<size_t>(sent[k]));
+        // Ids are drawn when the matcher builds the order: increasing ids = arrival order held
+        EXPECT_TRUE(std::is_sorted(ids.begin(), ids.end()));
+    }
+}
+
+TEST_F(MatcherPoolSuite, CancelIsRejectedOutsideItsLane) {
+    const Symbol btc("BTC/USD"), eth("ETH/USD");
+    auto resting = engine.submitOrder(LimitOrderRequest{100.0, 1.0, Side::BUY, btc, "REST"});
+    std::vector<EngineResponse> replies;
+    std::mutex replyMutex;
+    auto keep = [&](EngineResponse&& resp) {
+        std::lock_guard lock(replyMutex);
+        replies.push_back(std::move(resp));
+    };
+    {
+        MatcherPool pool(engine, 2);
+        ASSERT_TRUE(pool.start());
+        submitUntilAccepted(pool, {CancelRequest{resting.order->orderID, eth}, keep});
+        pool.stop();
+        submitUntilAccepted(pool, {CancelRequest{resting.order->orderID, btc}, keep});
+        pool.stop();
+    }
+    ASSERT_EQ(replies.size(), 2u);
+    EXPECT_EQ(replies[0].code, EngineStatusCode::VALIDATION_FAILURE);
+    EXPECT_TRUE(replies[1].isSuccess());
+    EXPECT_EQ(engine.getOrder(resting.order->orderID).order->status, OrderStatus::CANCELLED);
+}
+
+TEST_F(MatcherPoolSuite, RefusesToStartOnAPersistentEngine) {
+    const std::string path = (std::filesystem::temp_directory_path() /
+                              ("pool_" + std::to_string(::getpid()) + ".jnl")).string();
+    std::filesystem::remove(path);
+    ASSERT_TRUE(engine.attachJournal(path).isSuccess());
+    MatcherPool pool(engine, 2);
+    EXPECT_FALSE(pool.start());
+    std::filesystem::remove(path);
+}
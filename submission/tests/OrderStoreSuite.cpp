@@ -0,0 +1,207 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include "TradingEngine.hpp"
+
+class OrderStoreSuite : public ::testing::Test {
+protected:
+    const Symbol sym{"BTC/USD"};
+    const size_t capacity = 1024;
+    std::string path;
+
+    void SetUp() override {
+        path = (std::filesystem::temp_directory_path() /
+                ("order_store_" + std::to_string(::getpid()) + ".slab")).string();
+        std::filesystem::remove(path);
+    }
+    void TearDown() override { std::filesystem::remove(path); }
+};
+
+TEST_F(OrderStoreSuite, RestartRebuildsBooksAndRegistry) {
+    OrderBookSnapshot before;
+    OrderID icebergId = 0;
+    {
+        TradingEngine engine;
+        ASSERT_TRUE(engine.attachStore(path, capacity).isSuccess());
+        engine.submitOrder(LimitOrderRequest{100.0, 1.0, Side::BUY, sym, "B1"});
+        engine.submitOrder(LimitOrderRequest{100.0, 2.0, Side::BUY, sym, "B2"});
+        icebergId = engine.submitOrder(IcebergOrderRequest{101.0, 5.0, 1.0, Side::SELL, sym, "ICE"}).order->orderID;
+        engine.submitOrder(PeggedOrderRequest{PegType::PRIMARY, 1.5, Side::BUY, sym, "PEG"});
+        engine.submitOrder(LimitOrderRequest{101.0, 1.5, Side::BUY, sym, "HIT"}); // Reloads the iceberg
+        engine.cancelOrderByTag("B2");
+        before = engine.getOrderBookSnapshot(sym, 10).snapshot.value();
+        EXPECT_EQ(engine.getStoreSequence(), 6u);
+    }
+
+    TradingEngine restarted;
+    auto resp = restarted.attachStore(path, capacity);
+    ASSERT_TRUE(resp.isSuccess()) << resp.message;
+
+    auto after = restarted.getOrderBookSnapshot(sym, 10).snapshot.value();
+    EXPECT_EQ(after.digest, before.digest);
+    ASSERT_EQ(after.bids.size(), before.bids.size());
+    ASSERT_EQ(after.asks.size(), before.asks.size());
+    EXPECT_DOUBLE_EQ(after.asks[0].quantity, 0.5); // Reloaded slice, not the full iceberg
+
+    auto ice = restarted.getOrder(icebergId);
+    ASSERT_TRUE(ice.isSuccess());
+    EXPECT_DOUBLE_EQ(ice.order->remainingQuantity, 3.5);
+    EXPECT_EQ(restarted.getOrderByTag("B2").order->status, OrderStatus::CANCELLED);
+    EXPECT_EQ(restarted.getOrderByTag("HIT").order->status, OrderStatus::FILLED);
+}
+
+TEST_F(OrderStoreSuite, RestoredQueueKeepsTimePriorityAndIdentities) {
+    OrderID lastId = 0;
+    {
+        TradingEngine engine;
+        ASSERT_TRUE(engine.attachStore(path, capacity).isSuccess());
+        engine.submitOrder(LimitOrderRequest{100.0, 1.0, Side::SELL, sym, "FIRST"});
+        lastId = engine.submitOrder(LimitOrderRequest{100.0, 1.0, Side::SELL, sym, "SECOND"}).order->orderID;
+    }
+
+    TradingEngine restarted;
+    ASSERT_TRUE(restarted.attachStore(path, capacity).isSuccess());
+    auto taker = restarted.submitOrder(LimitOrderRequest{100.0, 1.0, Side::BUY, sym, "T"});
+    ASSERT_EQ(taker.fills.size(), 1u);
+    EXPECT_EQ(taker.fills[0].makerOrderId, restarted.getOrderByTag("FIRST").order->orderID);
+    EXPECT_GT(taker.order->orderID, lastId);
+
+    // Tags survive the restart, so they still collide
+    EXPECT_EQ(restarted.submitOrder(LimitOrderRequest{99.0, 1.0, Side::BUY, sym, "SECOND"}).code,
+              EngineStatusCode::DUPLICATE_TAG);
+}
+
+TEST_F(OrderStoreSuite, TornRequestIsRolledBackOnAttach) {
+    OrderID restingId = 0;
+    {
+        TradingEngine engine;
+        ASSERT_TRUE(engine.attachStore(path, capacity).isSuccess());
+        restingId = engine.submitOrder(LimitOrderRequest{100.0, 2.0, Side::BUY, sym, "REST"}).order->orderID;
+    }
+    {
+        // Simulates a crash part-way through rewriting a record
+        OrderSlab slab;
+        ASSERT_TRUE(slab.open(path, capacity).empty());
+        slab.beginWrite();
+        slab.stage(0);
+        slab.at(0).remainingQuantity = 0.5;
+        slab.at(0).status = static_cast<uint8_t>(OrderStatus::FILLED);
+    }
+    {
+        TradingEngine engine;
+        auto resp = engine.attachStore(path, capacity);
+        ASSERT_TRUE(resp.isSuccess()) << resp.message;
+        EXPECT_EQ(resp.message, "Restored 1 orders (rolled back a half-written request)");
+        auto rest = engine.getOrder(restingId).order;
+        EXPECT_EQ(rest->status, OrderStatus::ACTIVE);
+        EXPECT_DOUBLE_EQ(rest->remainingQuantity, 2.0);
+        EXPECT_EQ(engine.getStoreSequence(), 2u);
+        EXPECT_TRUE(engine.submitOrder(LimitOrderRequest{99.0, 1.0, Side::BUY, sym, "NEXT"}).isSuccess());
+    }
+    {
+        // ... and part-way through writing a freshly allocated one
+        OrderSlab slab;
+        ASSERT_TRUE(slab.open(path, capacity).empty());
+        EXPECT_FALSE(slab.wasRepaired());
+        slab.beginWrite();
+        slab.at(slab.allocate()).orderID = 999;
+    }
+    TradingEngine engine;
+    auto resp = engine.attachStore(path, capacity);
+    EXPECT_EQ(resp.message, "Restored 2 orders (rolled back a half-written request)");
+    EXPECT_FALSE(engine.getOrder(999).isSuccess());
+    EXPECT_TRUE(engine.submitOrder(LimitOrderRequest{98.0, 1.0, Side::BUY, sym, "LAST"}).isSuccess());
+}
+
+TEST_F(OrderStoreSuite, TornSweepRollsBackEveryOrderItTouched) {
+    OrderBookSnapshot before;
+    {
+        TradingEngine engine;
+        ASSERT_TRUE(engine.attachStore(path, capacity).isSuccess());
+        engine.submitOrder(LimitOrderRequest{100.0, 1.0, Side::SELL, sym, "M0"});
+        engine.submitOrder(LimitOrderRequest{100.0, 1.0, Side::SELL, sym, "M1"});
+        engine.submitOrder(LimitOrderRequest{101.0, 2.0, Side::SELL, sym, "M2"});
+        before = engine.getOrderBookSnapshot(sym, 10).snapshot.value();
+    }
+    {
+        // Simulates a crash while persisting a taker that swept M0 and M1 and is part-way into M2
+        OrderSlab slab;
+        ASSERT_TRUE(slab.open(path, capacity).empty());
+        slab.beginWrite();
+        uint32_t taker = slab.allocate();
+        slab.at(taker).orderID = 999;
+        slab.at(taker).status = static_cast<uint8_t>(OrderStatus::FILLED);
+        for (uint32_t maker : {0u, 1u}) {
+            slab.stage(maker);
+            slab.at(maker).remainingQuantity = 0.0;
+            slab.at(maker).status = static_cast<uint8_t>(OrderStatus::FILLED);
+        }
+        slab.stage(2);
+        slab.at(2).remainingQuantity = 1.5;
+        slab.stage(0); // A second pre-image of M0 must not shadow the first
+        slab.at(0).price = 0.0;
+    }
+
+    TradingEngine engine;
+    auto resp = engine.attachStore(path, capacity);
+    ASSERT_TRUE(resp.isSuccess()) << resp.message;
+    EXPECT_EQ(resp.message, "Restored 3 orders (rolled back a half-written request)");
+    EXPECT_FALSE(engine.getOrder(999).isSuccess());
+    for (const char* tag : {"M0", "M1", "M2"}) {
+        EXPECT_EQ(engine.getOrderByTag(tag).order->status, OrderStatus::ACTIVE) << tag;
+    }
+    EXPECT_DOUBLE_EQ(engine.getOrderByTag("M0").order->price, 100.0);
+    EXPECT_DOUBLE_EQ(engine.getOrderByTag("M2").order->remainingQuantity, 2.0);
+    EXPECT_EQ(engine.getOrderBookSnapshot(sym, 10).snapshot.value().digest, before.digest);
+
+    // The sweep itself, done for real, balances on both sides
+    auto taker = engine.submitOrder(LimitOrderRequest{101.0, 2.5, Side::BUY, sym, "T"});
+    ASSERT_EQ(taker.fills.size(), 3u);
+    EXPECT_DOUBLE_EQ(engine.getOrderByTag("M2").order->remainingQuantity, 1.5);
+}
+
+TEST_F(OrderStoreSuite, TornResetIsRolledForward) {
+    {
+        TradingEngine engine;
+        ASSERT_TRUE(engine.attachStore(path, capacity).isSuccess());
+        engine.submitOrder(LimitOrderRequest{100.0, 1.0, Side::BUY, sym, "A"});
+        engine.submitOrder(LimitOrderRequest{99.0, 1.0, Side::BUY, sym, "B"});
+    }
+    {
+        // Cut off after the header is cleared but before every slot is
+        OrderSlab slab;
+        ASSERT_TRUE(slab.open(path, capacity).empty());
+        slab.beginWrite();
+        slab.clear();
+        slab.at(1).inUse = 1;
+    }
+    TradingEngine engine;
+    auto resp = engine.attachStore(path, capacity);
+    ASSERT_TRUE(resp.isSuccess()) << resp.message;
+    EXPECT_FALSE(engine.getOrderByTag("A").isSuccess());
+    EXPECT_FALSE(engine.getOrderByTag("B").isSuccess());
+}
+
+TEST_F(OrderStoreSuite, RejectsMismatchedStores) {
+    {
+        OrderSlab slab;
+        ASSERT_TRUE(slab.open(path, capacity).empty());
+    }
+    TradingEngine engine;
+    EXPECT_EQ(engine.attachStore(path, capacity * 2).code, EngineStatusCode::STORE_FAILURE);
+}
+
+TEST_F(OrderStoreSuite, ArchivalAndResetFreeSlots) {
+    TradingEngine engine;
+    ASSERT_TRUE(engine.attachStore(path, 2).isSuccess());
+    engine.submitOrder(LimitOrderRequest{100.0, 1.0, Side::BUY, sym, "A"});
+    engine.cancelOrderByTag("A");
+    engine.submitOrder(LimitOrderRequest{100.0, 1.0, Side::BUY, sym, "B"});
+    EXPECT_EQ(engine.submitOrder(LimitOrderRequest{100.0, 1.0, Side::BUY, sym, "C"}).message, "Order store full");
+
+    EXPECT_EQ(engine.archiveTerminalOrders(Config::ARCHIVE_BATCH), 1u);
+    EXPECT_TRUE(engine.submitOrder(LimitOrderRequest{100.0, 1.0, Side::BUY, sym, "C"}).isSuccess());
+
+    engine.reset();
+    EXPECT_TRUE(engine.submitOrder(LimitOrderRequest{100.0, 1.0, Side::BUY, sym, "D"}).isSuccess());
+    EXPECT_TRUE(engine.submitOrder(LimitOrderRequest{100.0, 1.0, Side::BUY, sym, "E"}).isSuccess());
+}
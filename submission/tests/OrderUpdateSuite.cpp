@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include "TradingEngine.hpp"
+
+class OrderUpdateSuite : public ::testing::Test {
+protected:
+    TradingEngine engine;
+    const Symbol btc{"BTC/USD"};
+    const Symbol eth{"ETH/USD"};
+    std::vector<OrderUpdate> received;
+
+    OrderUpdateCallback collect() {
+        return [this](const OrderUpdate& u) { received.push_back(u); };
+    }
+
+    static std::vector<OrderUpdateKind> kinds(const std::vector<OrderUpdate>& updates) {
+        std::vector<OrderUpdateKind> out;
+        for (const auto& u : updates) out.push_back(u.kind);
+        return out;
+    }
+};
+
+TEST_F(OrderUpdateSuite, LifecycleTransitionsArePushedInOrder) {
+    engine.subscribe(SubscriptionFilter::all(), collect());
+
+    auto maker = engine.submitOrder(LimitOrderRequest{100.0, 5.0, Side::SELL, btc, "M"});
+    auto taker = engine.submitOrder(LimitOrderRequest{100.0, 2.0, Side::BUY, btc, "T"});
+    engine.cancelOrder(maker.order->orderID);
+
+    using K = OrderUpdateKind;
+    ASSERT_EQ(kinds(received), (std::vector<K>{K::ACK, K::ACK, K::PARTIAL_FILL, K::FILL, K::CANCEL}));
+    EXPECT_EQ(received[2].orderId, maker.order->orderID);
+    EXPECT_DOUBLE_EQ(received[2].leavesQuantity, 3.0);
+    EXPECT_EQ(received[3].orderId, taker.order->orderID);
+    EXPECT_EQ(received[3].executionId, received[2].executionId);
+    EXPECT_DOUBLE_EQ(received[3].lastPrice, 100.0);
+    EXPECT_DOUBLE_EQ(received[3].lastQuantity, 2.0);
+    EXPECT_DOUBLE_EQ(received[4].leavesQuantity, 3.0);
+}
+
+TEST_F(OrderUpdateSuite, FiltersSelectBySessionAndSymbol) {
+    std::vector<OrderUpdate> bySession, bySymbol;
+    engine.subscribe(SubscriptionFilter::forSession(7), [&](const OrderUpdate& u) { bySession.push_back(u); });
+    engine.subscribe(SubscriptionFilter::forSymbol(eth), [&](const OrderUpdate& u) { bySymbol.push_back(u); });
+
+    engine.submitOrder(LimitOrderRequest{100.0, 1.0, Side::SELL, btc, "A", 7});
+    engine.submitOrder(LimitOrderRequest{100.0, 1.0, Side::BUY, btc, "B", 8}); // Fills A
+    engine.submitOrder(LimitOrderRequest{10.0, 1.0, Side::BUY, eth, "C", 8});
+
+    using K = OrderUpdateKind;
+    EXPECT_EQ(kinds(bySession), (std::vector<K>{K::ACK, K::FILL})); // Only order A, incl. its maker fill
+    for (const auto& u : bySession) EXPECT_EQ(u.session, 7u);
+    ASSERT_EQ(bySymbol.size(), 1u);
+    EXPECT_EQ(bySymbol[0].symbol, eth);
+}
+
+TEST_F(OrderUpdateSuite, UnexecutedMarketRemainderIsCancelled) {
+    engine.subscribe(SubscriptionFilter::all(), collect());
+    engine.submitOrder(LimitOrderRequest{100.0, 1.0, Side::SELL, btc, "M"});
+    engine.submitOrder(MarketOrderRequest{3.0, Side::BUY, btc, "MKT"});
+
+    using K = OrderUpdateKind;
+    ASSERT_EQ(kinds(received), (std::vector<K>{K::ACK, K::ACK, K::FILL, K::PARTIAL_FILL, K::CANCEL}));
+    EXPECT_DOUBLE_EQ(received.back().leavesQuantity, 2.0);
+}
+
+TEST_F(OrderUpdateSuite, QueueSubscriberAndUnsubscribe) {
+    OrderUpdateQueue queue;
+    SubscriptionID id = engine.subscribe(SubscriptionFilter::all(), queue);
+
+    engine.submitOrder(LimitOrderRequest{100.0, 1.0, Side::SELL, btc, "A"});
+    OrderUpdate update;
+    ASSERT_TRUE(queue.poll(update));
+    EXPECT_EQ(update.kind, OrderUpdateKind::ACK);
+    EXPECT_FALSE(queue.poll(update));
+
+    engine.unsubscribe(id);
+    engine.submitOrder(LimitOrderRequest{101.0, 1.0, Side::SELL, btc, "B"});
+    EXPECT_FALSE(queue.poll(update));
+    EXPECT_EQ(queue.getDropped(), 0u);
+}
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include "TradingEngine.hpp"
+
+class PeggedOrderSuite : public ::testing::Test {
+protected:
+    TradingEngine engine;
+    const Symbol sym{"BTC/USD"};
+
+    void seedBbo() {
+        engine.submitOrder(LimitOrderRequest{99.0, 5.0, Side::BUY, sym, "BID"});
+        engine.submitOrder(LimitOrderRequest{101.0, 5.0, Side::SELL, sym, "ASK"});
+    }
+};
+
+TEST_F(PeggedOrderSuite, PeggedOrderRestsWithoutMatching) {
+    seedBbo();
+    auto res = engine.submitOrder(PeggedOrderRequest{PegType::MID, 1.0, Side::BUY, sym, "PEG"});
+
+    ASSERT_TRUE(res.isSuccess());
+    EXPECT_EQ(res.order->status, OrderStatus::ACTIVE);
+    EXPECT_EQ(res.message, "Pegged order posted to book");
+
+    // Pegs are not displayed on the ladder
+    auto snap = engine.getOrderBookSnapshot(sym, 5).snapshot.value();
+    ASSERT_EQ(snap.bids.size(), 1u);
+    EXPECT_DOUBLE_EQ(snap.bids[0].quantity, 5.0);
+}
+
+TEST_F(PeggedOrderSuite, MidPegTradesAheadOfLadderAtMidpoint) {
+    seedBbo();
+    engine.submitOrder(PeggedOrderRequest{PegType::MID, 1.0, Side::SELL, sym, "PEG"});
+
+    auto res = engine.submitOrder(MarketOrderRequest{1.0, Side::BUY, sym, "TAKER"});
+    ASSERT_TRUE(res.isSuccess());
+    EXPECT_DOUBLE_EQ(res.order->cumulativeCost, 100.0); // (99 + 101) / 2
+
+    EXPECT_EQ(engine.getOrderByTag("PEG").order->status, OrderStatus::FILLED);
+    EXPECT_DOUBLE_EQ(engine.getOrderByTag("ASK").order->remainingQuantity, 5.0);
+}
+
+TEST_F(PeggedOrderSuite, PrimaryPegFollowsBboWithoutRepricing) {
+    seedBbo();
+    engine.submitOrder(PeggedOrderRequest{PegType::PRIMARY, 2.0, Side::SELL, sym, "PEG"});
+
+    // A better ask moves the reference; the peg follows without any cancel/replace
+    engine.submitOrder(LimitOrderRequest{100.5, 1.0, Side::SELL, sym, "BETTER_ASK"});
+
+    // BETTER_ASK arrived after the peg, so at an equal price the peg trades first
+    auto res = engine.submitOrder(LimitOrderRequest{100.5, 2.5, Side::BUY, sym, "TAKER"});
+    ASSERT_TRUE(res.isSuccess());
+    EXPECT_EQ(engine.getOrderByTag("PEG").order->status, OrderStatus::FILLED);
+    EXPECT_DOUBLE_EQ(engine.getOrderByTag("BETTER_ASK").order->remainingQuantity, 0.5);
+    EXPECT_DOUBLE_EQ(res.order->cumulativeCost, 2.5 * 100.5);
+}
+
+TEST_F(PeggedOrderSuite, OpposingMidPegsTradeAtTheMidpointInsteadOfLocking) {
+    seedBbo();
+    auto resting = engine.submitOrder(PeggedOrderRequest{PegType::MID, 1.0, Side::BUY, sym, "MID_BUY"});
+    auto older = engine.submitOrder(PeggedOrderRequest{PegType::MID, 0.5, Side::BUY, sym, "MID_BUY2"});
+
+    auto res = engine.submitOrder(PeggedOrderRequest{PegType::MID, 2.0, Side::SELL, sym, "MID_SELL"});
+    ASSERT_EQ(res.fills.size(), 2u);
+    EXPECT_EQ(res.fills[0].makerOrderId, resting.order->orderID); // Time priority within the lane
+    EXPECT_DOUBLE_EQ(res.fills[0].price, 100.0);
+    EXPECT_DOUBLE_EQ(res.order->cumulativeCost, 150.0);
+    EXPECT_EQ(older.order->status, OrderStatus::FILLED);
+
+    // The remainder rests, and the ladder was never touched
+    EXPECT_EQ(res.order->status, OrderStatus::ACTIVE);
+    EXPECT_DOUBLE_EQ(res.order->remainingQuantity, 0.5);
+    EXPECT_DOUBLE_EQ(engine.getOrderByTag("BID").order->remainingQuantity, 5.0);
+    EXPECT_DOUBLE_EQ(engine.getOrderByTag("ASK").order->remainingQuantity, 5.0);
+
+    // Primary pegs sit at their own touch and never cross each other
+    engine.submitOrder(PeggedOrderRequest{PegType::PRIMARY, 1.0, Side::BUY, sym, "PRI_BUY"});
+    EXPECT_TRUE(engine.submitOrder(PeggedOrderRequest{PegType::PRIMARY, 1.0, Side::SELL, sym, "PRI_SELL"}).fills.empty());
+}
+
+TEST_F(PeggedOrderSuite, PegWithoutReferencePriceIsNotMatchable) {
+    // No bids exist, so a mid peg has no price and the market order finds no liquidity
+    engine.submitOrder(PeggedOrderRequest{PegType::MID, 1.0, Side::SELL, sym, "PEG"});
+    auto res = engine.submitOrder(MarketOrderRequest{1.0, Side::BUY, sym, "TAKER"});
+
+    EXPECT_EQ(res.order->status, OrderStatus::CANCELLED);
+    EXPECT_EQ(engine.getOrderByTag("PEG").order->status, OrderStatus::ACTIVE);
+}
+
+TEST_F(PeggedOrderSuite, CancelPeggedOrder) {
+    seedBbo();
+    auto res = engine.submitOrder(PeggedOrderRequest{PegType::PRIMARY, 1.0, Side::BUY, sym, "PEG"});
+
+    EXPECT_TRUE(engine.cancelOrder(res.order->orderID).isSuccess());
+    EXPECT_EQ(res.order->status, OrderStatus::CANCELLED);
+    EXPECT_DOUBLE_EQ(res.order->remainingQuantity, 1.0);
+
+    // The cancelled peg no longer competes for the incoming sell
+    auto sell = engine.submitOrder(MarketOrderRequest{1.0, Side::SELL, sym, "TAKER"});
+    EXPECT_DOUBLE_EQ(sell.order->cumulativeCost, 99.0);
+    EXPECT_DOUBLE_EQ(engine.getOrderByTag("BID").order->remainingQuantity, 4.0);
+}
+
+TEST_F(PeggedOrderSuite, RejectsMissingPegType) {
+    auto res = engine.submitOrder(PeggedOrderRequest{PegType::NONE, 1.0, Side::BUY, sym, "PEG"});
+    EXPECT_EQ(res.code, EngineStatusCode::VALIDATION_FAILURE);
+}
@@ -1,22 +1,31 @@
 #include <gtest/gtest.h>
+#include <thread>
+#include <iomanip>
 #include "TradingEngine.hpp"
 #include "Constants.hpp"
+#include "BenchReport.hpp"
 
+// Shared by every test in the suite; written once after the last one (BENCH_REPORT=<file>)
 class PerformanceSuite : public ::testing::Test {
 protected:
     TradingEngine engine;
+    static inline BenchReport report{"PerformanceSuite"};
+
+    static void TearDownTestSuite() {
+        EXPECT_TRUE(report.writeIfRequested()) << "Cannot write BENCH_REPORT";
+    }
 };
 
 // measure the latency of each individual order, store them in a vector, sort them, and then extract the percentiles.
 TEST_F(PerformanceSuite, LatencyPercentileAnalysis) {
-    const Symbol sym = "BTC/USD";
+    const Symbol sym{"BTC/USD"};
     const int iterations = 50000;
     std::vector<double> latencies;
     latencies.reserve(iterations);
 
     // Warm up the engine (JIT/Branch Prediction)
     for(int i = 0; i < 1000; ++i) {
-        engine.submitOrder(LimitOrderRequest{"WARM", sym, Side::BUY, 1.0, 100.0});
+        engine.submitOrder(LimitOrderRequest{100.0, 1.0, Side::BUY, sym, "WARM"});
     }
 
     // Actual Measurement Loop
@@ -25,9 +34,9 @@ TEST_F(PerformanceSuite, LatencyPercentileAnalysis) {
         
         // Use a mix: half Limit (Maker), half Market (Taker)
         if (i % 2 == 0) {
-            engine.submitOrder(LimitOrderRequest{"L_"+std::to_string(i), sym, Side::BUY, 1.0, 100.0});
+            engine.submitOrder(LimitOrderRequest{100.0, 1.0, Side::BUY, sym, "L_"+std::to_string(i)});
         } else {
-            engine.submitOrder(MarketOrderRequest{"M_"+std::to_string(i), sym, Side::SELL, 1.0});
+            engine.submitOrder(MarketOrderRequest{1.0, Side::SELL, sym, "M_"+std::to_string(i)});
         }
 
         auto end = std::chrono::high_resolution_clock::now();
@@ -51,6 +60,8 @@ TEST_F(PerformanceSuite, LatencyPercentileAnalysis) {
     std::cout << "P99.9 (Tail):  " << std::setw(10) << getPercentile(99.9) << " ns" << std::endl;
     std::cout << "Max Latency:   " << std::setw(10) << latencies.back() << " ns" << std::endl;
     std::cout << "==========================================" << std::endl;
+
+    report.addDistribution("limit_market_latency", "ns", BenchReport::Better::LOWER, latencies);
 }
 
 // Verify that engine achieves parallel speedup; that the engine scales with increasing number of symbols and their respective OrderBooks that it manages.
@@ -60,17 +71,18 @@ TEST_F(PerformanceSuite, FullScalingStressTest) {
     
     auto workload = [this](Symbol sym, int count) {
         for(int i = 0; i < count; ++i) {
-            engine.submitOrder(LimitOrderRequest{"M_" + sym + std::to_string(i), sym, Side::BUY, 1.0, 100.0});
+            engine.submitOrder(LimitOrderRequest{100.0, 1.0, Side::BUY, sym, "M_" + sym.name() + std::to_string(i)});
         }
-        engine.submitOrder(MarketOrderRequest{"SWEEP_" + sym, sym, Side::SELL, (double)count});
+        engine.submitOrder(MarketOrderRequest{(double)count, Side::SELL, sym, "SWEEP_" + sym.name()});
     };
 
     auto runScenario = [&](int numSymbols) {
+        engine.reset(); // Each scenario starts from empty books and a fresh tag space
         std::vector<std::thread> threads;
         auto start = std::chrono::high_resolution_clock::now();
 
         for(int i = 0; i < numSymbols; ++i) {
-            threads.emplace_back(workload, Config::TRADED_SYMBOLS[i], matchesPerSymbol);
+            threads.emplace_back(workload, Symbol(Config::TRADED_SYMBOLS[i]), matchesPerSymbol);
         }
         for(auto& t : threads) t.join();
 
@@ -94,6 +106,9 @@ TEST_F(PerformanceSuite, FullScalingStressTest) {
         std::cout << label << " Symbol(s): " << duration << " ms | " 
                   << "Factor: " << std::fixed << std::setprecision(2) << scaling << "x | "
                   << "Throughput: " << (int)throughput << " ops/sec" << std::endl;
+
+        std::string symbols = label.substr(0, label.find_last_not_of(' ') + 1);
+        report.addScalar("scaling_throughput_" + symbols + "_symbols", "ops/s", BenchReport::Better::HIGHER, throughput);
     };
 
     std::cout << "\n======================================================" << std::endl;
@@ -109,13 +124,13 @@ TEST_F(PerformanceSuite, FullScalingStressTest) {
 
 // intentionally create contention by having one thread try to delete data (Cancel) while another is trying to read and modify it (Match).
 TEST_F(PerformanceSuite, RaceConditionStress) {
-    const Symbol sym = "BTC/USD";
+    const Symbol sym{"BTC/USD"};
     const int orderCount = 5000;
     const double price = 100.0;
 
     // 1. Setup: Fill the book with identifiable orders
     for(int i = 0; i < orderCount; ++i) {
-        engine.submitOrder(LimitOrderRequest{"T_" + std::to_string(i), sym, Side::BUY, 1.0, price});
+        engine.submitOrder(LimitOrderRequest{price, 1.0, Side::BUY, sym, "T_" + std::to_string(i)});
     }
 
     // 2. Race: Cancel vs. Execute
@@ -123,25 +138,25 @@ TEST_F(PerformanceSuite, RaceConditionStress) {
 
     std::thread crusher([&]() {
         for(int i = 0; i < orderCount; ++i) {
-            engine.cancelOrderByTag("T_" + std::to_string(i), sym);
+            engine.cancelOrderByTag("T_" + std::to_string(i));
         }
     });
 
     std::thread sweeper([&]() {
         // Attempt to sweep half the book
-        engine.submitOrder(MarketOrderRequest{"SWEEPER", sym, Side::SELL, (double)orderCount / 2.0});
+        engine.submitOrder(MarketOrderRequest{(double)orderCount / 2.0, Side::SELL, sym, "SWEEPER"});
     });
 
     crusher.join();
     sweeper.join();
 
     // 3. Validation: The State Check
-    auto snapshot = std::get<OrderBookSnapshot>(engine.getOrderBook(sym, 1).data);
+    auto snapshot = engine.getOrderBookSnapshot(sym, 1).snapshot.value();
     
     // Check for "Ghost Volume" or "Negative Volume"
     double remainingVol = 0.0;
     if (!snapshot.bids.empty()) {
-        remainingVol = snapshot.bids[0].size;
+        remainingVol = snapshot.bids[0].quantity;
     }
 
     std::cout << "[ CHAOS ] Remaining Volume after Race: " << remainingVol << std::endl;
@@ -151,7 +166,7 @@ TEST_F(PerformanceSuite, RaceConditionStress) {
     
     // Verify Registry Cleanup: Try to cancel everything again; should fail if already gone
     for(int i = 0; i < orderCount; ++i) {
-        auto res = engine.cancelOrderByTag("T_" + std::to_string(i), sym);
+        auto res = engine.cancelOrderByTag("T_" + std::to_string(i));
         // If it's not in the registry and not on the book, it worked.
         EXPECT_FALSE(res.isSuccess());
     }
@@ -159,7 +174,7 @@ TEST_F(PerformanceSuite, RaceConditionStress) {
 
 // This test fills the book with orders across a wide price range, then measures how long it takes to execute a "Sweep" that must traverse many different memory nodes.
 TEST_F(PerformanceSuite, OrderDensityStress) {
-    const Symbol sym = "BTC/USD";
+    const Symbol sym{"BTC/USD"};
     const int priceLevels = 1000; // 1,000 distinct price points
     const int ordersPerLevel = 5;  // 5,000 total orders
     
@@ -169,8 +184,8 @@ TEST_F(PerformanceSuite, OrderDensityStress) {
         double price = 50000.0 + (i * 0.5); // Spread prices by $0.50
         for (int j = 0; j < ordersPerLevel; ++j) {
             engine.submitOrder(LimitOrderRequest{
-                "MKR_" + std::to_string(i) + "_" + std::to_string(j), 
-                sym, Side::BUY, 1.0, price
+                price, 1.0, Side::BUY, sym,
+                "MKR_" + std::to_string(i) + "_" + std::to_string(j)
             });
         }
     }
@@ -180,7 +195,7 @@ TEST_F(PerformanceSuite, OrderDensityStress) {
     auto start = std::chrono::high_resolution_clock::now();
     
     // This order is large enough to exhaust all 1,000 price levels
-    auto response = engine.submitOrder(MarketOrderRequest{"SWEEPER", sym, Side::SELL, 5000.0});
+    auto response = engine.submitOrder(MarketOrderRequest{5000.0, Side::SELL, sym, "SWEEPER"});
     
     auto end = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
@@ -194,4 +209,6 @@ TEST_F(PerformanceSuite, OrderDensityStress) {
     std::cout << "Total Time for Sweep:       " << duration << " us" << std::endl;
     std::cout << "Avg Time Per Level:         " << (double)duration / priceLevels << " us" << std::endl;
     std::cout << "==========================================" << std::endl;
+
+    report.addScalar("deep_sweep_1000_levels", "us", BenchReport::Better::LOWER, (double)duration);
 }
\ No newline at end of file
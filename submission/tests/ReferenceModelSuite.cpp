@@ -0,0 +1,392 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdlib>
+#include <map>
+#include <random>
+#include <sstream>
+#include "TradingEngine.hpp"
+
+// ====================================================================
+// Differential testing: a deliberately naive book model is driven in
+// lock-step with the real engine. The model keeps resting orders in one
+// flat vector and finds the best maker by a full scan every time, so its
+// price-time priority is obviously correct. Any structural optimisation
+// of OrderBook (ladder, queues, pegs, icebergs, grouped depth) must agree with it after
+// every single operation.
+//
+// REFMODEL_OPS   operations per seed (default 20000; raise to millions locally)
+// REFMODEL_SEEDS number of seeds       (default 4)
+// ====================================================================
+
+namespace {
+
+enum class OpKind { LIMIT, MARKET, ICEBERG, PEG, CANCEL };
+
+struct Op {
+    OpKind kind;
+    Side side;
+    double price;
+    double quantity;
+    double display;   // ICEBERG only
+    PegType peg;      // PEG only
+    size_t target;    // CANCEL: index into the orders accepted so far (mod count)
+};
+
+struct RefOrder {
+    OrderID id;
+    Side side;
+    OrderType type;
+    PegType peg;
+    double price;
+    double peak;
+    double remaining;          // Total, like Order::remainingQuantity
+    double displayed = 0.0;
+    double hidden = 0.0;
+    double cumulativeCost = 0.0;
+    SeqNum priority = 0;
+    OrderStatus status = OrderStatus::ACTIVE;
+    bool resting = false;
+};
+
+struct RefFill {
+    double price;
+    double quantity;
+    OrderID makerId;
+};
+
+class ReferenceBook {
+public:
+    std::map<OrderID, RefOrder> orders;   // Every order ever seen, for state comparison
+    std::vector<RefOrder*> live;          // Resting orders in no particular order (map nodes are stable)
+
+    std::vector<RefFill> submit(RefOrder taker) {
+        std::vector<RefFill> fills;
+        if (taker.type != OrderType::PEGGED) {
+            while (Precision::isPositive(taker.remaining)) {
+                auto [maker, px] = bestMaker(taker.side);
+                if (!maker) break;
+                if (taker.type == OrderType::LIMIT) {
+                    bool crosses = (taker.side == Side::BUY)
+                        ? (px <= taker.price || Precision::equal(px, taker.price))
+                        : (px >= taker.price || Precision::equal(px, taker.price));
+                    if (!crosses) break;
+                }
+                fills.push_back(fill(*maker, taker, px));
+            }
+        } else if (taker.peg == PegType::MID) {
+            // Opposite mid pegs share the midpoint, so an arriving one takes them oldest first
+            auto bid = bestLadderPrice(Side::BUY);
+            auto ask = bestLadderPrice(Side::SELL);
+            while (bid && ask && Precision::isPositive(taker.remaining)) {
+                RefOrder* oldest = nullptr;
+                for (RefOrder* candidate : live) {
+                    if (candidate->side == taker.side || candidate->type != OrderType::PEGGED || candidate->peg != PegType::MID) continue;
+                    if (!oldest || candidate->priority < oldest->priority) oldest = candidate;
+                }
+                if (!oldest) break;
+                fills.push_back(fill(*oldest, taker, (*bid + *ask) / 2.0));
+            }
+        }
+
+        if (Precision::isPositive(taker.remaining)) {
+            if (taker.type == OrderType::MARKET) {
+                taker.status = OrderStatus::CANCELLED;
+            } else {
+                taker.displayed = taker.remaining;
+                if (Precision::isPositive(taker.peak) && taker.peak < taker.remaining) {
+                    taker.displayed = taker.peak;
+                    taker.hidden = taker.remaining - taker.peak;
+                }
+                taker.priority = clock++;
+                taker.resting = true;
+            }
+        } else {
+            taker.status = OrderStatus::FILLED;
+            taker.remaining = 0.0;
+        }
+        RefOrder& stored = orders[taker.id] = taker;
+        if (stored.resting) live.push_back(&stored);
+        return fills;
+    }
+
+    bool cancel(OrderID id) {
+        auto it = orders.find(id);
+        if (it == orders.end() || !it->second.resting) return false;
+        it->second.resting = false;
+        it->second.status = OrderStatus::CANCELLED;
+        std::erase(live, &it->second);
+        it->second.remaining = it->second.displayed + it->second.hidden;
+        return true;
+    }
+
+    // Displayed ladder volume, best first; bucketSize > 0 re-buckets from scratch (bids floor, asks ceil)
+    std::vector<BookLevel> levels(Side side, double bucketSize = 0.0) const {
+        std::map<double, double> agg;
+        for (const RefOrder* o : live) {
+            if (o->side != side || o->type == OrderType::PEGGED) continue;
+            double px = o->price;
+            if (bucketSize > 0.0) px = ((side == Side::BUY) ? std::floor(px / bucketSize) : std::ceil(px / bucketSize)) * bucketSize;
+            agg[px] += o->displayed;
+        }
+        std::vector<BookLevel> out;
+        for (const auto& [px, qty] : agg) out.push_back({px, qty});
+        if (side == Side::BUY) std::reverse(out.begin(), out.end());
+        return out;
+    }
+
+private:
+    SeqNum clock = 0;
+
+    std::optional<double> bestLadderPrice(Side side) const {
+        std::optional<double> best;
+        for (const RefOrder* o : live) {
+            if (o->side != side || o->type == OrderType::PEGGED) continue;
+            if (!best || (side == Side::BUY ? o->price > *best : o->price < *best)) best = o->price;
+        }
+        return best;
+    }
+
+    static std::optional<double> effectivePrice(const RefOrder& o, std::optional<double> bid, std::optional<double> ask) {
+        if (o.type != OrderType::PEGGED) return o.price;
+        if (o.peg == PegType::PRIMARY) return (o.side == Side::BUY) ? bid : ask;
+        if (!bid || !ask) return std::nullopt;
+        return (*bid + *ask) / 2.0;
+    }
+
+    // Returns the best maker and its effective price given the current BBO
+    std::pair<RefOrder*, double> bestMaker(Side takerSide) {
+        Side makerSide = (takerSide == Side::BUY) ? Side::SELL : Side::BUY;
+        auto bid = bestLadderPrice(Side::BUY);
+        auto ask = bestLadderPrice(Side::SELL);
+        RefOrder* best = nullptr;
+        double bestPx = 0.0;
+        for (RefOrder* candidate : live) {
+            RefOrder& o = *candidate;
+            if (o.side != makerSide) continue;
+            auto px = effectivePrice(o, bid, ask);
+            if (!px) continue;
+            bool better = !best
+                || (!Precision::equal(*px, bestPx) && (makerSide == Side::SELL ? *px < bestPx : *px > bestPx))
+                || (Precision::equal(*px, bestPx) && o.priority < best->priority);
+            if (better) { best = &o; bestPx = *px; }
+        }
+        return {best, bestPx};
+    }
+
+    RefFill fill(RefOrder& maker, RefOrder& taker, double px) {
+        double qty = std::min(taker.remaining, maker.displayed);
+        Precision::subtract_or_zero(maker.displayed, qty);
+        Precision::subtract_or_zero(maker.remaining, qty);
+        maker.cumulativeCost += qty * px;
+        Precision::subtract_or_zero(taker.remaining, qty);
+        taker.cumulativeCost += qty * px;
+
+        if (Precision::isZero(maker.displayed)) {
+            if (Precision::isPositive(maker.hidden)) {
+                double slice = std::min(maker.peak, maker.hidden);
+                maker.displayed = slice;
+                Precision::subtract_or_zero(maker.hidden, slice);
+                maker.priority = clock++;
+            } else {
+                maker.resting = false;
+                maker.status = OrderStatus::FILLED;
+                maker.remaining = 0.0;
+                std::erase(live, &maker);
+            }
+        }
+        return {px, qty, maker.id};
+    }
+};
+
+// Shell-syntax rendering so a shrunk failure can be pasted straight into kraken_submission
+std::string render(const Op& op) {
+    std::ostringstream os;
+    const char* side = (op.side == Side::BUY) ? "BUY" : "SELL";
+    switch (op.kind) {
+        case OpKind::LIMIT:   os << "LIMIT " << side << " BTC/USD " << op.quantity << " " << op.price; break;
+        case OpKind::MARKET:  os << "MARKET " << side << " BTC/USD " << op.quantity; break;
+        case OpKind::ICEBERG: os << "ICEBERG " << side << " BTC/USD " << op.quantity << " " << op.display << " " << op.price; break;
+        case OpKind::PEG:     os << "PEG " << side << " BTC/USD " << op.quantity << (op.peg == PegType::MID ? " MID" : " PRIMARY"); break;
+        case OpKind::CANCEL:  os << "CANCEL #" << op.target; break;
+    }
+    return os.str();
+}
+
+std::vector<Op> generate(std::mt19937_64& rng, size_t count) {
+    // Prices on a 0.5 grid and quantities in halves keep every sum exact in binary,
+    // so the model and the engine can be compared without accumulated rounding noise.
+    std::uniform_int_distribution<int> kind(0, 99), ticks(0, 20), halves(1, 20), coin(0, 1);
+    std::vector<Op> ops;
+    ops.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        int k = kind(rng);
+        Op op{};
+        op.side = coin(rng) ? Side::BUY : Side::SELL;
+        op.price = 95.0 + ticks(rng) * 0.5;
+        op.quantity = halves(rng) * 0.5;
+        op.target = static_cast<size_t>(rng());
+        if (k < 45)       op.kind = OpKind::LIMIT;
+        else if (k < 60)  op.kind = OpKind::MARKET;
+        else if (k < 70)  { op.kind = OpKind::ICEBERG; op.display = std::min(op.quantity, halves(rng) * 0.25); }
+        else if (k < 80)  { op.kind = OpKind::PEG; op.peg = coin(rng) ? PegType::MID : PegType::PRIMARY; }
+        else              op.kind = OpKind::CANCEL;
+        ops.push_back(op);
+    }
+    return ops;
+}
+
+// Replays 'ops' against a freshly reset engine and a fresh model.
+// Returns a description of the first divergence, or nullopt if both agree throughout.
+std::optional<std::string> runDifferential(TradingEngine& engine, const std::vector<Op>& ops) {
+    engine.reset();
+    ReferenceBook model;
+    const Symbol sym{"BTC/USD"};
+    std::vector<OrderID> accepted;
+
+    auto compareOrder = [&](OrderID id) -> std::optional<std::string> {
+        const RefOrder& ref = model.orders.at(id);
+        auto res = engine.getOrder(id);
+        if (!res.isSuccess()) return "order " + std::to_string(id) + " missing from engine";
+        const Order& o = *res.order;
+        if (o.status != ref.status) return "status mismatch on order " + std::to_string(id);
+        if (!Precision::equal(o.remainingQuantity, ref.remaining)) return "remaining mismatch on order " + std::to_string(id);
+        if (!Precision::equal(o.cumulativeCost, ref.cumulativeCost)) return "cost mismatch on order " + std::to_string(id);
+        return std::nullopt;
+    };
+
+    auto compareSide = [](const std::vector<BookLevel>& real, const std::vector<BookLevel>& ref) {
+        if (real.size() != ref.size()) return false;
+        for (size_t i = 0; i < real.size(); ++i) {
+            if (!Precision::equal(real[i].price, ref[i].price) || !Precision::equal(real[i].quantity, ref[i].quantity)) return false;
+        }
+        return true;
+    };
+
+    for (size_t step = 0; step < ops.size(); ++step) {
+        const Op& op = ops[step];
+        const std::string tag = "R" + std::to_string(step);
+        std::vector<OrderID> touched;
+
+        if (op.kind == OpKind::CANCEL) {
+            if (accepted.empty()) continue;
+            OrderID id = accepted[op.target % accepted.size()];
+            bool real = engine.cancelOrder(id).isSuccess();
+            if (real != model.cancel(id)) return "cancel outcome mismatch at step " + std::to_string(step);
+            touched.push_back(id);
+        } else {
+            EngineResponse res;
+            RefOrder ref{};
+            ref.side = op.side;
+            ref.remaining = op.quantity;
+            switch (op.kind) {
+                case OpKind::LIMIT:
+                    res = engine.submitOrder(LimitOrderRequest{op.price, op.quantity, op.side, sym, tag});
+                    ref.type = OrderType::LIMIT; ref.price = op.price; break;
+                case OpKind::MARKET:
+                    res = engine.submitOrder(MarketOrderRequest{op.quantity, op.side, sym, tag});
+                    ref.type = OrderType::MARKET; break;
+                case OpKind::ICEBERG:
+                    res = engine.submitOrder(IcebergOrderRequest{op.price, op.quantity, op.display, op.side, sym, tag});
+                    ref.type = OrderType::LIMIT; ref.price = op.price; ref.peak = op.display; break;
+                default:
+                    res = engine.submitOrder(PeggedOrderRequest{op.peg, op.quantity, op.side, sym, tag});
+                    ref.type = OrderType::PEGGED; ref.peg = op.peg; break;
+            }
+            if (!res.isSuccess()) return "engine rejected step " + std::to_string(step) + ": " + res.message;
+
+            ref.id = res.order->orderID;
+            accepted.push_back(ref.id);
+            auto refFills = model.submit(ref);
+
+            if (refFills.size() != res.fills.size()) return "fill count mismatch at step " + std::to_string(step);
+            for (size_t i = 0; i < refFills.size(); ++i) {
+                const auto& a = res.fills[i];
+                const auto& b = refFills[i];
+                if (a.makerOrderId != b.makerId || !Precision::equal(a.price, b.price) || !Precision::equal(a.quantity, b.quantity)) {
+                    return "fill " + std::to_string(i) + " mismatch at step " + std::to_string(step);
+                }
+                touched.push_back(a.makerOrderId);
+            }
+            touched.push_back(ref.id);
+        }
+
+        for (OrderID id : touched) {
+            if (auto err = compareOrder(id)) return *err + " at step " + std::to_string(step);
+        }
+
+        auto snap = engine.getOrderBookSnapshot(sym, Config::MAX_PRICE_LEVELS).snapshot.value();
+        if (!compareSide(snap.bids, model.levels(Side::BUY)) || !compareSide(snap.asks, model.levels(Side::SELL))) {
+            return "snapshot mismatch at step " + std::to_string(step);
+        }
+        for (double bucketSize : Config::DEPTH_BUCKET_SIZES) {
+            auto grouped = engine.getGroupedOrderBookSnapshot(sym, bucketSize, Config::MAX_GROUPED_DEPTH).snapshot.value();
+            if (!compareSide(grouped.bids, model.levels(Side::BUY, bucketSize)) ||
+                !compareSide(grouped.asks, model.levels(Side::SELL, bucketSize))) {
+                return "grouped depth mismatch at step " + std::to_string(step);
+            }
+        }
+
+        // Full state sweep at a coarser cadence keeps millions of steps affordable
+        if (step % 512 == 0 || step + 1 == ops.size()) {
+            for (const auto& [id, ref] : model.orders) {
+                if (auto err = compareOrder(id)) return *err + " at step " + std::to_string(step);
+            }
+        }
+    }
+    return std::nullopt;
+}
+
+// Greedy delta debugging: drop ever-smaller chunks while the divergence persists
+std::vector<Op> shrink(TradingEngine& engine, std::vector<Op> ops) {
+    for (size_t chunk = ops.size() / 2; chunk >= 1; chunk /= 2) {
+        size_t start = 0;
+        while (start < ops.size()) {
+            std::vector<Op> candidate;
+            candidate.reserve(ops.size());
+            candidate.insert(candidate.end(), ops.begin(), ops.begin() + start);
+            candidate.insert(candidate.end(), ops.begin() + std::min(ops.size(), start + chunk), ops.end());
+            if (runDifferential(engine, candidate)) ops = std::move(candidate);
+            else start += chunk;
+        }
+    }
+    return ops;
+}
+
+size_t envOr(const char* name, size_t fallback) {
+    const char* v = std::getenv(name);
+    return v ? std::strtoull(v, nullptr, 10) : fallback;
+}
+
+} // namespace
+
+TEST(ReferenceModelSuite, ModelHonoursPriceTimePriority) {
+    ReferenceBook model;
+    model.submit(RefOrder{1, Side::SELL, OrderType::LIMIT, PegType::NONE, 100.0, 0.0, 1.0});
+    model.submit(RefOrder{2, Side::SELL, OrderType::LIMIT, PegType::NONE, 100.0, 0.0, 1.0});
+    auto fills = model.submit(RefOrder{3, Side::BUY, OrderType::MARKET, PegType::NONE, 0.0, 0.0, 1.5});
+
+    ASSERT_EQ(fills.size(), 2u);
+    EXPECT_EQ(fills[0].makerId, 1u);
+    EXPECT_EQ(fills[1].makerId, 2u);
+    EXPECT_DOUBLE_EQ(fills[1].quantity, 0.5);
+}
+
+TEST(ReferenceModelSuite, RandomizedDifferentialAgainstEngine) {
+    const size_t opsPerSeed = envOr("REFMODEL_OPS", 20000);
+    const size_t seeds = envOr("REFMODEL_SEEDS", 4);
+    TradingEngine engine; // Reset between runs, so shrinking does not churn the allocator
+
+    for (size_t seed = 1; seed <= seeds; ++seed) {
+        std::mt19937_64 rng(seed);
+        auto ops = generate(rng, opsPerSeed);
+        auto failure = runDifferential(engine, ops);
+        if (!failure) continue;
+
+        auto minimal = shrink(engine, ops);
+        std::ostringstream repro;
+        for (const auto& op : minimal) repro << "  " << render(op) << "\n";
+        FAIL() << "seed " << seed << ": " << *failure << "\n"
+               << "minimal repro (" << minimal.size() << " ops, failing: "
+               << runDifferential(engine, minimal).value_or("?") << "):\n" << repro.str();
+    }
+}
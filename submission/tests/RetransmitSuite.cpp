@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include <future>
+#include "TradingEngine.hpp"
+#include "GapFillServer.hpp"
+
+class RetransmitSuite : public ::testing::Test {
+protected:
+    TradingEngine engine;
+    const Symbol sym{"BTC/USD"};
+
+    // 'count' single-lot fills reported to 'session' as maker
+    void fillMakers(SessionID session, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            engine.submitOrder(LimitOrderRequest{100.0, 1.0, Side::SELL, sym, "M" + std::to_string(i), session});
+        }
+        engine.submitOrder(MarketOrderRequest{static_cast<double>(count), Side::BUY, sym, "SWEEP"});
+    }
+
+    static GapFillReply ask(GapFillServer& server, SessionID session, uint64_t from, uint64_t to) {
+        std::promise<GapFillReply> promise;
+        auto future = promise.get_future();
+        EXPECT_TRUE(server.request({session, from, to, [&promise](GapFillReply&& r) { promise.set_value(std::move(r)); }}));
+        return future.get();
+    }
+};
+
+TEST_F(RetransmitSuite, StoreDetectsOverwrittenAndMissingSequences) {
+    RetransmitStore<uint64_t, 8> store;
+    uint64_t out = 0;
+    EXPECT_FALSE(store.read(1, out)); // Never written
+
+    for (uint64_t seq = 1; seq <= 10; ++seq) store.write(seq, seq * 100);
+    EXPECT_FALSE(store.read(2, out)); // Overwritten by 10
+    ASSERT_TRUE(store.read(3, out));
+    EXPECT_EQ(out, 300u);
+    ASSERT_TRUE(store.read(10, out));
+    EXPECT_EQ(out, 1000u);
+    EXPECT_FALSE(store.read(11, out));
+}
+
+TEST_F(RetransmitSuite, ReportsCarryContiguousSessionSequences) {
+    SessionEgress* egress = engine.openSession(5);
+    fillMakers(5, 3);
+
+    ExecutionReport report;
+    for (uint64_t expected = 1; expected <= 3; ++expected) {
+        ASSERT_TRUE(egress->poll(report));
+        EXPECT_EQ(report.sequence, expected);
+    }
+    EXPECT_EQ(egress->getLastSequence(), 3u);
+}
+
+TEST_F(RetransmitSuite, GapFillRecoversReportsDroppedByAFullRing) {
+    SessionEgress* egress = engine.openSession(5);
+    const size_t total = Config::EGRESS_RING_CAPACITY + 10;
+    fillMakers(5, total);
+    ASSERT_EQ(egress->getDropped(), 10u);
+
+    uint64_t lastSeen = 0;
+    ExecutionReport report;
+    while (egress->poll(report)) lastSeen = report.sequence;
+    ASSERT_EQ(lastSeen, Config::EGRESS_RING_CAPACITY);
+
+    GapFillServer server(engine);
+    server.start();
+    GapFillReply reply = ask(server, 5, lastSeen + 1, egress->getLastSequence());
+    EXPECT_TRUE(reply.complete);
+    ASSERT_EQ(reply.reports.size(), 10u);
+    for (size_t i = 0; i < reply.reports.size(); ++i) EXPECT_EQ(reply.reports[i].sequence, lastSeen + 1 + i);
+    EXPECT_TRUE(reply.reports.back().isMaker);
+
+    // Unknown sessions and sequences past the end of the stream are refused, not invented
+    EXPECT_FALSE(ask(server, 99, 1, 1).complete);
+    GapFillReply beyond = ask(server, 5, total, total + 5);
+    EXPECT_FALSE(beyond.complete);
+    EXPECT_TRUE(beyond.reports.empty());
+    server.stop();
+    EXPECT_EQ(server.getServed(), 3u);
+}
@@ -0,0 +1,42 @@
+#include <gtest/gtest.h>
+#include "TradingEngine.hpp"
+
+class SessionResetSuite : public ::testing::Test {
+protected:
+    TradingEngine engine;
+    const Symbol sym{"BTC/USD"};
+};
+
+TEST_F(SessionResetSuite, ResetForgetsOrdersAndEmptiesBooks) {
+    auto resting = engine.submitOrder(LimitOrderRequest{100.0, 2.0, Side::BUY, sym, "A"});
+    engine.submitOrder(PeggedOrderRequest{PegType::PRIMARY, 1.0, Side::BUY, sym, "P"});
+    engine.submitOrder(LimitOrderRequest{100.0, 1.0, Side::SELL, sym, "B"});
+
+    engine.reset();
+
+    EXPECT_EQ(engine.getOrder(resting.order->orderID).code, EngineStatusCode::ORDER_ID_NOT_FOUND);
+    EXPECT_EQ(engine.getOrderByTag("A").code, EngineStatusCode::TAG_NOT_FOUND);
+
+    // The book itself survives warm, but empty and back at sequence zero
+    auto snap = engine.getOrderBookSnapshot(sym, 5).snapshot.value();
+    EXPECT_TRUE(snap.bids.empty());
+    EXPECT_TRUE(snap.asks.empty());
+    EXPECT_EQ(snap.updateSeq, 0u);
+    EXPECT_EQ(snap.digest, 0u);
+}
+
+TEST_F(SessionResetSuite, NextSessionBehavesLikeFreshEngine) {
+    engine.submitOrder(LimitOrderRequest{100.0, 1.0, Side::BUY, sym, "A"});
+    engine.submitOrder(LimitOrderRequest{100.0, 1.0, Side::SELL, sym, "B"});
+    engine.reset();
+
+    // Tags are reusable and no last price bands the new session
+    auto a = engine.submitOrder(LimitOrderRequest{500.0, 1.0, Side::SELL, sym, "A"});
+    ASSERT_TRUE(a.isSuccess());
+    auto b = engine.submitOrder(LimitOrderRequest{500.0, 1.0, Side::BUY, sym, "B"});
+    ASSERT_TRUE(b.isSuccess());
+
+    ASSERT_EQ(b.fills.size(), 1u);
+    EXPECT_EQ(b.fills[0].executionId, 1000000u);
+    EXPECT_EQ(b.fills[0].makerOrderId, a.order->orderID);
+}
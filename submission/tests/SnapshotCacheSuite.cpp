@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include "TradingEngine.hpp"
+
+class SnapshotCacheSuite : public ::testing::Test {
+protected:
+    TradingEngine engine;
+    const Symbol sym{"BTC/USD"};
+
+    std::shared_ptr<const std::string> render(size_t depth, SnapshotFormat format = SnapshotFormat::TEXT) {
+        return engine.getRenderedSnapshot(sym, depth, format).rendered;
+    }
+};
+
+TEST_F(SnapshotCacheSuite, RepeatedRequestsShareOneBufferUntilTheBookChanges) {
+    engine.submitOrder(LimitOrderRequest{100.0, 1.0, Side::BUY, sym, "B"});
+    auto first = render(5);
+    ASSERT_TRUE(first);
+    EXPECT_EQ(render(5).get(), first.get());
+    EXPECT_EQ(*first, renderSnapshotText(engine.getOrderBookSnapshot(sym, 5).snapshot.value()));
+
+    // Other depths and formats are cached separately
+    EXPECT_NE(render(1).get(), first.get());
+    EXPECT_NE(render(5, SnapshotFormat::BINARY).get(), first.get());
+
+    engine.submitOrder(LimitOrderRequest{101.0, 1.0, Side::SELL, sym, "S"});
+    auto second = render(5);
+    EXPECT_NE(second.get(), first.get());
+    EXPECT_EQ(first->find("101"), std::string::npos); // Holders of the old version keep it intact
+    EXPECT_NE(second->find("101"), std::string::npos);
+}
+
+TEST_F(SnapshotCacheSuite, BinaryLayoutCarriesVersionAndLevels) {
+    engine.submitOrder(LimitOrderRequest{100.0, 2.0, Side::BUY, sym, "B"});
+    engine.submitOrder(LimitOrderRequest{101.0, 3.0, Side::SELL, sym, "S"});
+    auto bytes = render(5, SnapshotFormat::BINARY);
+    ASSERT_EQ(bytes->size(), sizeof(SnapshotWireHeader) + 2 * sizeof(BookLevel));
+
+    SnapshotWireHeader header;
+    std::memcpy(&header, bytes->data(), sizeof(header));
+    EXPECT_EQ(header.magic, SnapshotWireHeader::MAGIC);
+    EXPECT_EQ(header.symbol, sym);
+    EXPECT_EQ(header.updateSeq, 2u);
+    EXPECT_EQ(header.bidCount, 1u);
+    EXPECT_EQ(header.askCount, 1u);
+
+    BookLevel ask;
+    std::memcpy(&ask, bytes->data() + sizeof(header) + sizeof(BookLevel), sizeof(ask));
+    EXPECT_DOUBLE_EQ(ask.price, 101.0);
+    EXPECT_DOUBLE_EQ(ask.quantity, 3.0);
+}
+
+TEST_F(SnapshotCacheSuite, ResetDropsRenderingsOfTheOldSession) {
+    engine.submitOrder(LimitOrderRequest{100.0, 1.0, Side::BUY, sym, "B"});
+    auto before = render(5);
+    engine.reset();
+    engine.submitOrder(LimitOrderRequest{90.0, 1.0, Side::BUY, sym, "B2"}); // Same sequence as before
+    auto after = render(5);
+    EXPECT_NE(after.get(), before.get());
+    EXPECT_NE(after->find("90"), std::string::npos);
+}
@@ -0,0 +1,37 @@
+#include <gtest/gtest.h>
+#include "TradingEngine.hpp"
+
+class TagFilterSuite : public ::testing::Test {
+protected:
+    TradingEngine engine;
+    const Symbol sym{"BTC/USD"};
+};
+
+TEST_F(TagFilterSuite, NoFalseNegativesAndFewFalsePositives) {
+    TagFilter filter;
+    constexpr int inserted = 100000;
+    for (int i = 0; i < inserted; ++i) filter.insert("tag-" + std::to_string(i));
+    for (int i = 0; i < inserted; ++i) ASSERT_TRUE(filter.mayContain("tag-" + std::to_string(i)));
+
+    int falsePositives = 0;
+    for (int i = 0; i < inserted; ++i) falsePositives += filter.mayContain("other-" + std::to_string(i));
+    EXPECT_LT(falsePositives, inserted / 1000); // Far below capacity: practically exact
+
+    filter.clear();
+    EXPECT_FALSE(filter.mayContain("tag-0"));
+}
+
+TEST_F(TagFilterSuite, DuplicatesAreRejectedEvenAfterArchival) {
+    engine.submitOrder(LimitOrderRequest{100.0, 1.0, Side::SELL, sym, "M"});
+    engine.submitOrder(LimitOrderRequest{100.0, 1.0, Side::BUY, sym, "T"});
+    ASSERT_EQ(engine.archiveTerminalOrders(Config::ARCHIVE_BATCH), 2u);
+
+    auto dup = engine.submitOrder(LimitOrderRequest{100.0, 1.0, Side::BUY, sym, "T"});
+    EXPECT_EQ(dup.code, EngineStatusCode::DUPLICATE_TAG);
+    EXPECT_EQ(engine.getOrderByTag("M").order->status, OrderStatus::FILLED);
+    EXPECT_EQ(engine.cancelOrderByTag("M").code, EngineStatusCode::ALREADY_TERMINAL);
+
+    // A new session starts with an empty filter
+    engine.reset();
+    EXPECT_TRUE(engine.submitOrder(LimitOrderRequest{100.0, 1.0, Side::BUY, sym, "T"}).isSuccess());
+}
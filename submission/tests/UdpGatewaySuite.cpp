@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <poll.h>
+#include "TradingEngine.hpp"
+#include "UdpGateway.hpp"
+
+class UdpGatewaySuite : public ::testing::Test {
+protected:
+    TradingEngine engine;
+    UdpGateway gateway{engine};
+    int client = -1;
+    sockaddr_in target{};
+
+    void SetUp() override {
+        ASSERT_EQ(gateway.bind("127.0.0.1:0"), "");
+        client = ::socket(AF_INET, SOCK_DGRAM, 0);
+        timeval timeout{2, 0};
+        ::setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        target.sin_family = AF_INET;
+        target.sin_port = htons(gateway.getPort());
+        target.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    }
+    void TearDown() override { ::close(client); }
+
+    std::string roundTrip(std::string_view request) { return roundTrip(client, request); }
+
+    std::string roundTrip(int from, std::string_view request) {
+        ::sendto(from, request.data(), request.size(), 0, reinterpret_cast<const sockaddr*>(&target), sizeof(target));
+        pollfd pfd{gateway.getFd(), POLLIN, 0};
+        ::poll(&pfd, 1, 2000);
+        EXPECT_EQ(gateway.drain(), 1u);
+        char reply[4096];
+        ssize_t n = ::recv(from, reply, sizeof(reply), 0);
+        return (n > 0) ? std::string(reply, static_cast<size_t>(n)) : std::string{};
+    }
+};
+
+TEST_F(UdpGatewaySuite, HistogramBucketsByPowerOfTwo) {
+    LatencyHistogram h;
+    EXPECT_EQ(h.percentile(0.5), 0u);
+    for (uint64_t ns : {0, 1, 900, 1000, 1023, 5000}) h.record(ns);
+    EXPECT_EQ(h.getCount(), 6u);
+    EXPECT_EQ(h.getMax(), 5000u);
+    EXPECT_EQ(h.percentile(0.0), 0u);
+    EXPECT_EQ(h.percentile(0.5), 1023u); // 900..1023 share the [512, 1024) bucket
+    EXPECT_EQ(h.percentile(1.0), 5000u); // Capped at the observed max, not the bucket bound
+}
+
+TEST_F(UdpGatewaySuite, CommandsRoundTripAndEveryStageIsTimed) {
+    std::string posted = roundTrip("LIMIT SELL BTC/USD 1 100 G1\n");
+    EXPECT_EQ(posted.rfind("OK Order posted to book id=", 0), 0u);
+    EXPECT_NE(posted.find(" rem=1.000000 fills=0"), std::string::npos);
+    EXPECT_EQ(roundTrip("MARKET BUY BTC/USD 1 G2").rfind("OK Order fully filled", 0), 0u);
+    EXPECT_EQ(roundTrip("CANCEL 424242").rfind("ERR ", 0), 0u);
+    EXPECT_EQ(roundTrip("QUIT"), "ERR Unknown command");
+
+    for (size_t s = 0; s < static_cast<size_t>(GatewayStage::COUNT); ++s) {
+        EXPECT_EQ(gateway.getHistogram(static_cast<GatewayStage>(s)).getCount(), 4u) << UdpGateway::stageName(static_cast<GatewayStage>(s));
+    }
+    // Kernel timestamps are on: the socket queue is measured, not assumed zero
+    EXPECT_EQ(gateway.getUntimestamped(), 0u);
+    EXPECT_GE(gateway.getHistogram(GatewayStage::TICK_TO_TRADE).getMax(),
+              gateway.getHistogram(GatewayStage::DISPATCH).getMax());
+}
+
+TEST_F(UdpGatewaySuite, SessionCommandsAreNotServedRemotely) {
+    roundTrip("LIMIT SELL BTC/USD 1 100 KEEP");
+    EXPECT_EQ(roundTrip("RESET"), "ERR Unknown command");
+    EXPECT_TRUE(engine.getOrderByTag("KEEP").isSuccess());
+    EXPECT_EQ(roundTrip("DIGEST BTC/USD").rfind("OK Digest: ", 0), 0u);
+}
+
+TEST_F(UdpGatewaySuite, RefusesToBindBeyondLoopback) {
+    UdpGateway exposed{engine};
+    EXPECT_EQ(exposed.bind("0.0.0.0:0"), "Gateway binds to loopback only");
+    EXPECT_EQ(exposed.bind("10.1.2.3:0"), "Gateway binds to loopback only");
+    EXPECT_EQ(exposed.bind("127.0.0.2:0"), "");
+}
+
+TEST_F(UdpGatewaySuite, PeersCancelOnlyTheirOwnOrders) {
+    roundTrip("LIMIT SELL BTC/USD 1 100 MINE");
+    OrderID id = engine.getOrderByTag("MINE").order->orderID;
+
+    int other = ::socket(AF_INET, SOCK_DGRAM, 0);
+    timeval timeout{2, 0};
+    ::setsockopt(other, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    EXPECT_EQ(roundTrip(other, "CANCEL " + std::to_string(id)), "ERR 102 ID missing");
+    EXPECT_EQ(engine.getOrder(id).order->status, OrderStatus::ACTIVE);
+    ::close(other);
+
+    EXPECT_EQ(roundTrip("CANCEL " + std::to_string(id)).rfind("OK ", 0), 0u);
+    EXPECT_EQ(engine.getOrder(id).order->status, OrderStatus::CANCELLED);
+}
+
+TEST_F(UdpGatewaySuite, OversizedRequestIsRefusedNotDispatched) {
+    // A valid command whose tag runs past the datagram limit: its prefix must not be acted on
+    std::string request = "LIMIT SELL BTC/USD 1 100 " + std::string(Config::GATEWAY_MAX_DATAGRAM, 'T');
+    EXPECT_EQ(roundTrip(request).rfind("ERR 400 Request exceeds", 0), 0u);
+    EXPECT_EQ(gateway.getTruncated(), 1u);
+    EXPECT_EQ(gateway.getHistogram(GatewayStage::DISPATCH).getCount(), 0u);
+    EXPECT_FALSE(engine.getOrderBookSnapshot(Symbol("BTC/USD"), 5).isSuccess());
+}
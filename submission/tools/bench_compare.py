@@ -0,0 +1,143 @@
+#!/usr/bin/env python3
+"""Compare a benchmark report against a stored baseline (schema "kraken-bench/1").
+
+    BENCH_REPORT=run.json ./unit_tests --gtest_filter='PerformanceSuite.*'
+    tools/bench_compare.py --baseline base*.json --run run*.json [--threshold 5] [--tail-threshold 10] [--z 3]
+
+Several reports per side are pooled: each report then contributes its mean as one
+observation, which is what gives single-shot metrics (throughput, sweep time) a variance.
+A single report keeps its own per-sample statistics.
+
+A metric regresses when it moves in its worse direction by more than --threshold percent
+and, if both sides carry more than one sample, the shift is also significant (Welch's
+t statistic above --z). Tail percentiles (p99, p999) are checked on relative change of
+their median across reports against --tail-threshold. Exits 1 if anything regressed,
+2 on unusable input.
+"""
+
+import argparse
+import json
+import math
+import statistics
+import sys
+
+SCHEMA = "kraken-bench/1"
+TAIL_FIELDS = ("p99", "p999")
+
+
+def load(path):
+    try:
+        with open(path) as f:
+            report = json.load(f)
+    except (OSError, ValueError) as err:
+        print(f"bench_compare: cannot read {path}: {err}", file=sys.stderr)
+        sys.exit(2)
+    if report.get("schema") != SCHEMA:
+        print(f"bench_compare: {path} is not a {SCHEMA} report", file=sys.stderr)
+        sys.exit(2)
+    return report
+
+
+def pool(reports):
+    """Merges reports into one metric list (first report's order)."""
+    if len(reports) == 1:
+        return reports[0]["metrics"]
+    by_name = {}
+    for report in reports:
+        for metric in report["metrics"]:
+            by_name.setdefault(metric["name"], []).append(metric)
+    pooled = []
+    for name, runs in by_name.items():
+        means = [m["mean"] for m in runs]
+        merged = {"name": name, "unit": runs[0]["unit"], "better": runs[0]["better"],
+                  "samples": len(means), "mean": statistics.fmean(means),
+                  "stddev": statistics.stdev(means) if len(means) > 1 else 0.0}
+        for field in TAIL_FIELDS:
+            if all(field in m for m in runs):
+                merged[field] = statistics.median(m[field] for m in runs)
+        pooled.append(merged)
+    return pooled
+
+
+def worse_pct(base, run, better):
+    """Relative change in percent, positive when 'run' is worse than 'base'."""
+    if base == 0:
+        return 0.0
+    change = (run - base) / abs(base) * 100.0
+    return change if better == "lower" else -change
+
+
+def welch_t(a, b):
+    """|t| for the difference of means, or None when either side has no spread information."""
+    if a["samples"] < 2 or b["samples"] < 2:
+        return None
+    var = a["stddev"] ** 2 / a["samples"] + b["stddev"] ** 2 / b["samples"]
+    if var == 0:
+        return math.inf if a["mean"] != b["mean"] else 0.0
+    return abs(a["mean"] - b["mean"]) / math.sqrt(var)
+
+
+def compare(baseline, run, args):
+    base_metrics = {m["name"]: m for m in baseline}
+    rows, regressions = [], 0
+
+    for metric in run:
+        name = metric["name"]
+        base = base_metrics.get(name)
+        if base is None:
+            rows.append((name, "mean", "-", metric["mean"], "", "NEW"))
+            continue
+
+        better = metric["better"]
+        change = worse_pct(base["mean"], metric["mean"], better)
+        t = welch_t(base, metric)
+        significant = t is None or t > args.z
+        verdict = "REGRESSED" if change > args.threshold and significant else "ok"
+        if change < -args.threshold and significant:
+            verdict = "improved"
+        note = "" if t is None else f"t={t:.1f}"
+        rows.append((name, "mean", base["mean"], metric["mean"], f"{change:+.1f}% {note}".strip(), verdict))
+        regressions += verdict == "REGRESSED"
+
+        for field in TAIL_FIELDS:
+            if field in base and field in metric:
+                change = worse_pct(base[field], metric[field], better)
+                verdict = "REGRESSED" if change > args.tail_threshold else "ok"
+                rows.append((name, field, base[field], metric[field], f"{change:+.1f}%", verdict))
+                regressions += verdict == "REGRESSED"
+
+    for name in base_metrics.keys() - {m["name"] for m in run}:
+        rows.append((name, "mean", base_metrics[name]["mean"], "-", "", "MISSING"))
+
+    return rows, regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--baseline", nargs="+", required=True, help="baseline report(s)")
+    parser.add_argument("--run", nargs="+", required=True, help="report(s) of the run under test")
+    parser.add_argument("--threshold", type=float, default=5.0, help="mean regression tolerance, percent")
+    parser.add_argument("--tail-threshold", type=float, default=10.0, help="p99/p999 regression tolerance, percent")
+    parser.add_argument("--z", type=float, default=3.0, help="minimum Welch t statistic for a significant shift")
+    args = parser.parse_args()
+
+    baseline = [load(path) for path in args.baseline]
+    run = [load(path) for path in args.run]
+    for label, reports in (("baseline", baseline), ("run", run)):
+        for report in reports:
+            env = report.get("environment", {})
+            print(f"{label:>8}: {env.get('timestamp', '?')} {env.get('host', '?')} "
+                  f"{env.get('build', '?')} rev={env.get('revision') or '?'}")
+
+    rows, regressions = compare(pool(baseline), pool(run), args)
+    fmt = lambda v: f"{v:.2f}" if isinstance(v, (int, float)) else str(v)
+    print(f"\n{'metric':<32} {'stat':<5} {'baseline':>14} {'run':>14}  {'change':<16} verdict")
+    for name, stat, base, cur, change, verdict in rows:
+        print(f"{name:<32} {stat:<5} {fmt(base):>14} {fmt(cur):>14}  {change:<16} {verdict}")
+
+    print(f"\n{regressions} regression(s)")
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())